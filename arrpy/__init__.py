@@ -0,0 +1,3 @@
+from .groupby import group_reduce
+from .sorting import topk
+from .window import rolling, sliding_window_view
@@ -0,0 +1,211 @@
+"""Complex arrays with interleaved storage.
+
+`ComplexArray` stores ``(real, imag)`` pairs back to back in a float64
+(complex128) or float32 (complex64) buffer. `real` and `imag` are strided
+memoryviews over that buffer, so reading or writing them never copies.
+
+Kernels stay in C by working on the two strided component views at once:
+``map(complex, real, imag)`` to widen, `math.hypot` and `math.atan2` for
+`abs` and `angle`, and slice assignment into the interleaved buffer to
+narrow results back.
+"""
+
+import cmath
+import math
+import operator
+from array import array
+from numbers import Integral, Number
+
+_DTYPES = {'complex128': 'd', 'complex64': 'f'}
+
+
+def _div(a, b):
+    # Complex division by zero as NumPy does it: each nonzero component of
+    # the numerator becomes a signed inf and each zero one becomes NaN.
+    try:
+        return a / b
+    except ZeroDivisionError:
+        if a == 0 or a != a:
+            return complex(math.nan, math.nan)
+        return complex(math.copysign(math.inf, a.real) if a.real else math.nan,
+                       math.copysign(math.inf, a.imag) if a.imag else math.nan)
+
+
+class ComplexArray:
+    """1-D array of complex numbers, ``dtype`` complex128 or complex64."""
+
+    def __init__(self, values=(), dtype='complex128'):
+        if dtype not in _DTYPES:
+            raise TypeError('dtype must be complex128 or complex64')
+        if isinstance(values, ComplexArray):
+            values = values.tolist()
+        else:
+            values = [complex(v) for v in values]
+        buf = array(_DTYPES[dtype], bytes(2 * len(values) *
+                                          array(_DTYPES[dtype]).itemsize))
+        mv = memoryview(buf)
+        mv[0::2] = array(_DTYPES[dtype], [z.real for z in values])
+        mv[1::2] = array(_DTYPES[dtype], [z.imag for z in values])
+        self.dtype = dtype
+        self._mv = mv
+
+    @classmethod
+    def frombuffer(cls, buffer, dtype='complex128'):
+        """Wrap native-endian interleaved ``(re, im)`` data without copying."""
+        if dtype not in _DTYPES:
+            raise TypeError('dtype must be complex128 or complex64')
+        mv = memoryview(buffer).cast('B').cast(_DTYPES[dtype])
+        if len(mv) % 2:
+            raise ValueError('buffer holds an odd number of components')
+        return cls._wrap(mv, dtype)
+
+    @classmethod
+    def _wrap(cls, mv, dtype):
+        out = cls.__new__(cls)
+        out.dtype = dtype
+        out._mv = mv
+        return out
+
+    @property
+    def real(self):
+        """Writable strided view of the real parts."""
+        return self._mv[0::2]
+
+    @property
+    def imag(self):
+        """Writable strided view of the imaginary parts."""
+        return self._mv[1::2]
+
+    @property
+    def nbytes(self):
+        return self._mv.nbytes
+
+    def __len__(self):
+        return len(self._mv) // 2
+
+    def tolist(self):
+        return list(map(complex, self._mv[0::2], self._mv[1::2]))
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            start, stop, step = key.indices(len(self))
+            if step == 1:
+                return self._wrap(self._mv[2 * start:2 * max(stop, start)],
+                                  self.dtype)
+            return ComplexArray(self.tolist()[key], self.dtype)
+        if not isinstance(key, Integral):
+            raise TypeError('indices must be integers or slices')
+        n = len(self)
+        if key < 0:
+            key += n
+        if not 0 <= key < n:
+            raise IndexError('index out of range')
+        return complex(self._mv[2 * key], self._mv[2 * key + 1])
+
+    def __setitem__(self, key, value):
+        if isinstance(key, slice):
+            idx = range(*key.indices(len(self)))
+            values = [complex(v) for v in value]
+            if len(values) != len(idx):
+                raise ValueError('slice assignment changes the array length')
+        else:
+            idx = [key % len(self)] if -len(self) <= key < len(self) else None
+            if idx is None:
+                raise IndexError('index out of range')
+            values = [complex(value)]
+        for i, z in zip(idx, values):
+            self._mv[2 * i] = z.real
+            self._mv[2 * i + 1] = z.imag
+
+    def _new(self, values):
+        return ComplexArray(values, self.dtype)
+
+    def _operands(self, other):
+        if isinstance(other, Number):
+            return None
+        b = other.tolist() if isinstance(other, ComplexArray) else list(other)
+        if len(b) != len(self):
+            raise ValueError('operands have different lengths')
+        return b
+
+    def _binary(self, other, op, swap=False):
+        a = self.tolist()
+        b = self._operands(other)
+        if b is None:
+            if swap:
+                return self._new([op(other, z) for z in a])
+            return self._new([op(z, other) for z in a])
+        return self._new(map(op, b, a) if swap else map(op, a, b))
+
+    def __add__(self, other):
+        return self._binary(other, operator.add)
+
+    def __sub__(self, other):
+        return self._binary(other, operator.sub)
+
+    def __rsub__(self, other):
+        return self._binary(other, operator.sub, swap=True)
+
+    def __mul__(self, other):
+        return self._binary(other, operator.mul)
+
+    def __truediv__(self, other):
+        return self._binary(other, _div)
+
+    def __rtruediv__(self, other):
+        return self._binary(other, _div, swap=True)
+
+    __radd__ = __add__
+    __rmul__ = __mul__
+
+    def __neg__(self):
+        out = self.copy()
+        mv = out._mv
+        mv[:] = array(mv.format, map(operator.neg, mv))
+        return out
+
+    def copy(self):
+        return self._wrap(memoryview(array(self._mv.format, self._mv)), self.dtype)
+
+    def conj(self):
+        """Complex conjugate; only the imaginary components are rewritten."""
+        out = self.copy()
+        mv = out._mv
+        mv[1::2] = array(mv.format, map(operator.neg, mv[1::2]))
+        return out
+
+    conjugate = conj
+
+    def __abs__(self):
+        return list(map(math.hypot, self._mv[0::2], self._mv[1::2]))
+
+    abs = __abs__
+
+    def angle(self, deg=False):
+        out = list(map(math.atan2, self._mv[1::2], self._mv[0::2]))
+        return [math.degrees(v) for v in out] if deg else out
+
+    def exp(self):
+        return self._new(map(cmath.exp, self.tolist()))
+
+    def sum(self):
+        return complex(math.fsum(self._mv[0::2]), math.fsum(self._mv[1::2]))
+
+    def vdot(self, other):
+        """``sum(conj(self) * other)``."""
+        b = self._operands(other)
+        return sum(map(operator.mul, self.conj().tolist(), b), 0j)
+
+    def __eq__(self, other):
+        b = self._operands(other)
+        if b is None:
+            return [z == other for z in self.tolist()]
+        return list(map(operator.eq, self.tolist(), b))
+
+    __hash__ = None
+
+    def __repr__(self):
+        return 'ComplexArray(%r, dtype=%r)' % (self.tolist(), self.dtype)
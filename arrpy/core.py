@@ -0,0 +1,105 @@
+"""Shape utilities for nested-list arrays.
+
+arrpy represents an n-dimensional array as nested Python lists (a scalar is
+0-d). The helpers here convert between that form and a flat row-major list
+plus a shape tuple, which is the layout most kernels iterate over. Scalar
+helpers shared by several array types live here too.
+"""
+
+import math
+
+
+def ieee_div(x, y):
+    """``x / y`` with IEEE 754 results for a zero divisor instead of raising.
+
+    A nonzero ``x`` gives an infinity signed by both operands; ``0 / 0`` and
+    NaN give NaN.
+    """
+    try:
+        return x / y
+    except ZeroDivisionError:
+        if x == 0 or x != x:
+            return math.nan
+        return math.copysign(math.inf, x) * math.copysign(1.0, y)
+
+
+def shape(a):
+    """Return the shape of a nested list, assuming it is rectangular."""
+    dims = []
+    while isinstance(a, (list, tuple)):
+        dims.append(len(a))
+        if not a:
+            break
+        a = a[0]
+    return tuple(dims)
+
+
+def ravel(a):
+    """Flatten a nested list into a new row-major list."""
+    if not isinstance(a, (list, tuple)):
+        return [a]
+    flat = list(a)
+    for _ in range(len(shape(a)) - 1):
+        flat = [x for row in flat for x in row]
+    return flat
+
+
+def reshape(flat, dims):
+    """Build a nested list of shape ``dims`` from a row-major sequence."""
+    flat = list(flat)
+    dims = tuple(dims)
+    if len(flat) != math.prod(dims):
+        raise ValueError('cannot reshape %d elements into shape %r'
+                         % (len(flat), dims))
+    if not dims:
+        return flat[0]
+
+    def build(offset, sub):
+        if len(sub) == 1:
+            return flat[offset:offset + sub[0]]
+        step = math.prod(sub[1:])
+        return [build(offset + i * step, sub[1:]) for i in range(sub[0])]
+
+    return build(0, dims)
+
+
+def normalize_axis(axis, ndim):
+    """Map a possibly negative axis into ``range(ndim)``."""
+    if not -ndim <= axis < ndim:
+        raise ValueError('axis %d is out of bounds for array of dimension %d'
+                         % (axis, ndim))
+    return axis % ndim
+
+
+def axis_slices(dims, axis):
+    """Yield a slice per 1-D lane along ``axis`` of a flat row-major array.
+
+    ``flat[s]`` reads a lane and ``flat[s] = values`` writes it back, both
+    as single C-level slice operations.
+    """
+    n = dims[axis]
+    stride = math.prod(dims[axis + 1:])
+    block = n * stride
+    for outer in range(math.prod(dims[:axis])):
+        base = outer * block
+        for inner in range(stride):
+            start = base + inner
+            yield slice(start, start + block, stride)
+
+
+def apply_along_axis(func, a, axis):
+    """Apply ``func`` to every 1-D lane of ``a`` along ``axis``.
+
+    ``func`` takes a list and returns a list; every lane must produce the
+    same length, which becomes the new extent of ``axis``.
+    """
+    dims = shape(a)
+    axis = normalize_axis(axis, len(dims))
+    flat = ravel(a)
+    lanes = [func(flat[s]) for s in axis_slices(dims, axis)]
+    m = len(lanes[0]) if lanes else dims[axis]
+    out_dims = dims[:axis] + (m,) + dims[axis + 1:]
+    out = [None] * math.prod(out_dims)
+    for s, lane in zip(axis_slices(out_dims, axis), lanes):
+        out[s] = lane
+    return reshape(out, out_dims)
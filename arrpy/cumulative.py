@@ -0,0 +1,124 @@
+"""Cumulative scans and discrete differences.
+
+Scans along the last axis run `itertools.accumulate` over each contiguous
+lane. Along an outer axis, lanes are strided but many, so the scan instead
+steps down the axis combining whole contiguous blocks of the trailing
+dimensions at once. Either way the per-element work stays in C.
+"""
+
+import math
+import operator
+from itertools import accumulate
+
+from .core import apply_along_axis, axis_slices, normalize_axis, ravel, reshape
+from .core import shape as _shape
+
+
+def _scan(a, axis, op):
+    if axis is None:
+        return list(accumulate(ravel(a), op))
+    dims = _shape(a)
+    axis = normalize_axis(axis, len(dims))
+    flat = ravel(a)
+    n = dims[axis]
+    inner = math.prod(dims[axis + 1:])
+    if inner >= n:
+        for outer in range(math.prod(dims[:axis])):
+            base = outer * n * inner
+            for i in range(1, n):
+                lo = base + i * inner
+                hi = lo + inner
+                flat[lo:hi] = map(op, flat[lo - inner:lo], flat[lo:hi])
+    else:
+        for s in axis_slices(dims, axis):
+            flat[s] = list(accumulate(flat[s], op))
+    return reshape(flat, dims)
+
+
+def cumsum(a, axis=None):
+    """Running sum along ``axis``; ``None`` scans the flattened input."""
+    return _scan(a, axis, operator.add)
+
+
+def cumprod(a, axis=None):
+    """Running product along ``axis``; ``None`` scans the flattened input."""
+    return _scan(a, axis, operator.mul)
+
+
+def cummin(a, axis=None):
+    """Running minimum along ``axis``; ``None`` scans the flattened input."""
+    return _scan(a, axis, min)
+
+
+def cummax(a, axis=None):
+    """Running maximum along ``axis``; ``None`` scans the flattened input."""
+    return _scan(a, axis, max)
+
+
+def _diff_lane(lane, n):
+    for _ in range(n):
+        lane = list(map(operator.sub, lane[1:], lane[:-1]))
+    return lane
+
+
+def _concat(parts, axis):
+    # Concatenate nested lists of equal rank along ``axis``.
+    if axis == 0:
+        return [row for part in parts for row in part]
+    return [_concat(rows, axis - 1) for rows in zip(*parts)]
+
+
+def _broadcast_edge(value, dims, axis):
+    # Scalar prepend/append values become a length-1 slab along ``axis``.
+    if isinstance(value, (list, tuple)):
+        return value
+    slab = dims[:axis] + (1,) + dims[axis + 1:]
+    return reshape([value] * math.prod(slab), slab)
+
+
+def diff(a, n=1, axis=-1, prepend=None, append=None):
+    """``n``-th discrete difference ``a[i + 1] - a[i]`` along ``axis``."""
+    if n < 0:
+        raise ValueError('order must be non-negative but got %d' % n)
+    dims = _shape(a)
+    if not dims:
+        raise ValueError('diff requires input that is at least one dimensional')
+    axis = normalize_axis(axis, len(dims))
+    if prepend is not None or append is not None:
+        parts = [a]
+        if prepend is not None:
+            parts.insert(0, _broadcast_edge(prepend, dims, axis))
+        if append is not None:
+            parts.append(_broadcast_edge(append, dims, axis))
+        a = _concat(parts, axis)
+        dims = _shape(a)
+    if n == 0:
+        return a
+    inner = math.prod(dims[axis + 1:])
+    if inner < dims[axis]:
+        return apply_along_axis(lambda lane: _diff_lane(lane, n), a, axis)
+    flat = ravel(a)
+    for _ in range(n):
+        m = dims[axis]
+        if m == 0:
+            break
+        out = []
+        for outer in range(math.prod(dims[:axis])):
+            base = outer * m * inner
+            for i in range(1, m):
+                lo = base + i * inner
+                out.extend(map(operator.sub, flat[lo:lo + inner],
+                               flat[lo - inner:lo]))
+        flat = out
+        dims = dims[:axis] + (m - 1,) + dims[axis + 1:]
+    return reshape(flat, dims)
+
+
+def ediff1d(ary, to_end=None, to_begin=None):
+    """Differences between consecutive elements of the flattened input."""
+    flat = ravel(ary)
+    out = [] if to_begin is None else ravel(to_begin)
+    out.extend(map(operator.sub, flat[1:], flat[:-1]))
+    if to_end is not None:
+        out.extend(ravel(to_end))
+    return out
@@ -0,0 +1,427 @@
+"""int64-backed datetime64 and timedelta64 arrays.
+
+Both types store integer tick counts in an ``array('q')`` together with a
+unit: ``'D'``, ``'h'``, ``'m'``, ``'s'``, ``'ms'``, ``'us'`` or ``'ns'``.
+Datetimes count ticks since 1970-01-01T00:00 (proleptic Gregorian, no time
+zone); the smallest int64 is NaT ("not a time") and propagates through
+arithmetic. Mixed-unit operations convert to the finer unit first.
+
+Calendar fields come from Howard Hinnant's ``civil_from_days``, which maps a
+day number to year/month/day with integer arithmetic only, so no
+`datetime` objects are created per element.
+"""
+
+import datetime as _dt
+import re
+from array import array
+from numbers import Integral, Real
+
+NAT = -2 ** 63
+
+_NS = {'D': 86400 * 10 ** 9, 'h': 3600 * 10 ** 9, 'm': 60 * 10 ** 9,
+       's': 10 ** 9, 'ms': 10 ** 6, 'us': 10 ** 3, 'ns': 1}
+
+_ISO = re.compile(
+    r'^\s*(-?\d{4,})-(\d{2})-(\d{2})'
+    r'(?:[T ](\d{2}):(\d{2})(?::(\d{2})(?:\.(\d{1,9}))?)?)?\s*$')
+
+_EPOCH_DAY = 719468  # days from 0000-03-01 to 1970-01-01
+
+
+def _check_unit(unit):
+    if unit not in _NS:
+        raise ValueError('unknown time unit %r; expected one of %s'
+                         % (unit, ', '.join(_NS)))
+    return unit
+
+
+def _parse_step(step):
+    # '15m' -> (15, 'm'); 'h' -> (1, 'h').
+    m = re.match(r'^(\d*)([A-Za-z]+)$', step)
+    if not m:
+        raise ValueError('invalid frequency %r' % (step,))
+    return int(m.group(1) or 1), _check_unit(m.group(2))
+
+
+def _finer(a, b):
+    return a if _NS[a] <= _NS[b] else b
+
+
+def _convert(ticks, src, dst):
+    if src == dst:
+        return list(ticks)
+    if _NS[src] >= _NS[dst]:
+        k = _NS[src] // _NS[dst]
+        return [t if t == NAT else t * k for t in ticks]
+    k = _NS[dst] // _NS[src]
+    return [t if t == NAT else t // k for t in ticks]
+
+
+def days_from_civil(y, m, d):
+    """Day number since 1970-01-01 of a proleptic Gregorian date."""
+    y -= m <= 2
+    era = y // 400
+    yoe = y - era * 400
+    doy = (153 * (m + 9 - 12 * (m > 2)) + 2) // 5 + d - 1
+    doe = yoe * 365 + yoe // 4 - yoe // 100 + doy
+    return era * 146097 + doe - _EPOCH_DAY
+
+
+def civil_from_days(z):
+    """``(year, month, day)`` of day number ``z`` since 1970-01-01."""
+    z += _EPOCH_DAY
+    era = z // 146097
+    doe = z - era * 146097
+    yoe = (doe - doe // 1460 + doe // 36524 - doe // 146096) // 365
+    doy = doe - (365 * yoe + yoe // 4 - yoe // 100)
+    mp = (5 * doy + 2) // 153
+    d = doy - (153 * mp + 2) // 5 + 1
+    m = mp + 3 - 12 * (mp // 10)
+    return yoe + era * 400 + (m <= 2), m, d
+
+
+def _days_in_month(y, m):
+    if m == 2:
+        return 29 if y % 4 == 0 and (y % 100 != 0 or y % 400 == 0) else 28
+    return 30 if m in (4, 6, 9, 11) else 31
+
+
+def _parse_iso(text):
+    if text.strip() == 'NaT':
+        return NAT, None
+    g = _ISO.match(text)
+    if not g:
+        raise ValueError('cannot parse datetime %r' % (text,))
+    year, month, day, hh, mm, ss, frac = g.groups()
+    year, month, day = int(year), int(month), int(day)
+    if not 1 <= month <= 12:
+        raise ValueError('month out of range in datetime %r' % (text,))
+    if not 1 <= day <= _days_in_month(year, month):
+        raise ValueError('day out of range in datetime %r' % (text,))
+    if hh is not None and (int(hh) > 23 or int(mm) > 59
+                           or (ss is not None and int(ss) > 59)):
+        raise ValueError('time out of range in datetime %r' % (text,))
+    days = days_from_civil(year, month, day)
+    ns = days * _NS['D']
+    if hh is None:
+        return ns, 'D'
+    ns += int(hh) * _NS['h'] + int(mm) * _NS['m']
+    if ss is None:
+        return ns, 'm'
+    ns += int(ss) * _NS['s']
+    if frac is None:
+        return ns, 's'
+    ns += int(frac.ljust(9, '0'))
+    return ns, 'ms' if len(frac) <= 3 else 'us' if len(frac) <= 6 else 'ns'
+
+
+def _parse_value(v):
+    # (nanoseconds since the epoch, precision unit) of one scalar input.
+    if v is None:
+        return NAT, None
+    if isinstance(v, str):
+        return _parse_iso(v)
+    if isinstance(v, _dt.datetime):
+        offset = v.utcoffset()
+        if offset is not None:
+            v = v.replace(tzinfo=None) - offset
+        ns = (days_from_civil(v.year, v.month, v.day) * _NS['D']
+              + v.hour * _NS['h'] + v.minute * _NS['m'] + v.second * _NS['s']
+              + v.microsecond * _NS['us'])
+        return ns, 'us' if v.microsecond else 's'
+    if isinstance(v, _dt.date):
+        return days_from_civil(v.year, v.month, v.day) * _NS['D'], 'D'
+    raise TypeError('cannot convert %r to datetime64' % (v,))
+
+
+class _TimeArray:
+    def __init__(self, ticks, unit):
+        self.unit = _check_unit(unit)
+        self._ticks = ticks if isinstance(ticks, array) else array('q', ticks)
+
+    @classmethod
+    def frombuffer(cls, buffer, unit):
+        """Wrap native int64 tick counts without copying."""
+        out = cls.__new__(cls)
+        out.unit = _check_unit(unit)
+        out._ticks = memoryview(buffer).cast('B').cast('q')
+        return out
+
+    def _new(self, ticks, unit=None):
+        return type(self)(array('q', ticks), unit or self.unit)
+
+    def __len__(self):
+        return len(self._ticks)
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            return self._new(self._ticks[key])
+        return self._ticks[key]
+
+    def tolist(self):
+        """Raw tick counts (NaT as `NAT`)."""
+        return list(self._ticks)
+
+    def isnat(self):
+        return [t == NAT for t in self._ticks]
+
+    def astype(self, unit):
+        """Convert to another unit; coarser units floor toward -inf."""
+        return self._new(_convert(self._ticks, self.unit, _check_unit(unit)), unit)
+
+    def _align(self, other):
+        # Both operands as tick lists in their common (finer) unit.
+        unit = _finer(self.unit, other.unit)
+        a = _convert(self._ticks, self.unit, unit)
+        b = _convert(other._ticks, other.unit, unit)
+        if len(b) == 1 and len(a) != 1:
+            b = b * len(a)
+        elif len(a) == 1 and len(b) != 1:
+            a = a * len(b)
+        if len(a) != len(b):
+            raise ValueError('operands have different lengths')
+        return a, b, unit
+
+    def _round(self, step, up):
+        n, unit = _parse_step(step)
+        q = n * _NS[unit]
+        if q % _NS[self.unit]:
+            raise ValueError('cannot round %s ticks to %r' % (self.unit, step))
+        q //= _NS[self.unit]
+        if up:
+            return self._new([t if t == NAT else -((-t) // q) * q
+                              for t in self._ticks])
+        return self._new([t if t == NAT else (t // q) * q for t in self._ticks])
+
+    def floor(self, step):
+        """Round down to a multiple of ``step`` (e.g. ``'h'`` or ``'15m'``)."""
+        return self._round(step, False)
+
+    def ceil(self, step):
+        """Round up to a multiple of ``step``."""
+        return self._round(step, True)
+
+    def _compare(self, other, op):
+        if not isinstance(other, type(self)):
+            return NotImplemented
+        a, b, _ = self._align(other)
+        return [False if x == NAT or y == NAT else op(x, y) for x, y in zip(a, b)]
+
+    def __eq__(self, other):
+        return self._compare(other, int.__eq__)
+
+    def __lt__(self, other):
+        return self._compare(other, int.__lt__)
+
+    def __le__(self, other):
+        return self._compare(other, int.__le__)
+
+    def __gt__(self, other):
+        return self._compare(other, int.__gt__)
+
+    def __ge__(self, other):
+        return self._compare(other, int.__ge__)
+
+    __hash__ = None
+
+
+class TimedeltaArray(_TimeArray):
+    """Durations as int64 tick counts in ``unit``."""
+
+    def _as_delta(self, other):
+        if isinstance(other, TimedeltaArray):
+            return other
+        if isinstance(other, Integral):
+            return TimedeltaArray([other], self.unit)
+        return NotImplemented
+
+    def __add__(self, other):
+        if isinstance(other, DatetimeArray):
+            return other + self
+        other = self._as_delta(other)
+        if other is NotImplemented:
+            return other
+        a, b, unit = self._align(other)
+        return TimedeltaArray([NAT if x == NAT or y == NAT else x + y
+                               for x, y in zip(a, b)], unit)
+
+    __radd__ = __add__
+
+    def __neg__(self):
+        return self._new([t if t == NAT else -t for t in self._ticks])
+
+    def __sub__(self, other):
+        other = self._as_delta(other)
+        if other is NotImplemented:
+            return other
+        return self + (-other)
+
+    def __mul__(self, k):
+        if not isinstance(k, Integral):
+            return NotImplemented
+        return self._new([t if t == NAT else t * k for t in self._ticks])
+
+    __rmul__ = __mul__
+
+    def __floordiv__(self, other):
+        if isinstance(other, Real):
+            return self._new([t if t == NAT else int(t // other)
+                              for t in self._ticks])
+        if not isinstance(other, TimedeltaArray):
+            return NotImplemented
+        a, b, _ = self._align(other)
+        return [None if x == NAT or y == NAT else x // y for x, y in zip(a, b)]
+
+    def __truediv__(self, other):
+        # Scaling by a number truncates toward zero to whole ticks, as NumPy
+        # does; dividing by durations gives float ratios.
+        if isinstance(other, Real):
+            return self._new([t if t == NAT else int(t / other)
+                              for t in self._ticks])
+        if not isinstance(other, TimedeltaArray):
+            return NotImplemented
+        a, b, _ = self._align(other)
+        return [float('nan') if x == NAT or y == NAT else x / y
+                for x, y in zip(a, b)]
+
+    def total_seconds(self):
+        scale = _NS[self.unit] / 1e9
+        return [float('nan') if t == NAT else t * scale for t in self._ticks]
+
+    def __repr__(self):
+        return 'TimedeltaArray(%r, unit=%r)' % (self.tolist(), self.unit)
+
+
+class DatetimeArray(_TimeArray):
+    """Points in time as int64 tick counts since the Unix epoch in ``unit``.
+
+    Construct from tick counts plus a ``unit``, or from ISO 8601 strings
+    (``'2024-03-01'``, ``'2024-03-01T12:30:05.25'``, ``'NaT'``) and
+    `datetime` objects, in which case ``unit`` defaults to the finest
+    precision present. Calendar fields of NaT entries are None.
+    """
+
+    def __init__(self, values, unit=None):
+        if not isinstance(values, array):
+            values = list(values)
+        # An empty list has no ticks to interpret; parse it like strings.
+        if isinstance(values, array) or values and all(
+                isinstance(v, Integral) for v in values):
+            if unit is None:
+                raise ValueError('unit is required for integer tick counts')
+            super().__init__(values, unit)
+            return
+        parsed = [_parse_value(v) for v in values]
+        if unit is None:
+            unit = 'D'
+            for _, precision in parsed:
+                if precision is not None:
+                    unit = _finer(unit, precision)
+        per = _NS[_check_unit(unit)]
+        super().__init__([NAT if ns == NAT else ns // per for ns, _ in parsed],
+                         unit)
+
+    def __add__(self, other):
+        if isinstance(other, Integral):
+            other = TimedeltaArray([other], self.unit)
+        if not isinstance(other, TimedeltaArray):
+            return NotImplemented
+        a, b, unit = self._align(other)
+        return DatetimeArray(array('q', [NAT if x == NAT or y == NAT else x + y
+                                         for x, y in zip(a, b)]), unit)
+
+    __radd__ = __add__
+
+    def __sub__(self, other):
+        if isinstance(other, DatetimeArray):
+            a, b, unit = self._align(other)
+            return TimedeltaArray([NAT if x == NAT or y == NAT else x - y
+                                   for x, y in zip(a, b)], unit)
+        if isinstance(other, Integral):
+            other = TimedeltaArray([other], self.unit)
+        if isinstance(other, TimedeltaArray):
+            return self + (-other)
+        return NotImplemented
+
+    def _days(self):
+        per_day = _NS['D'] // _NS[self.unit]
+        return [None if t == NAT else t // per_day for t in self._ticks]
+
+    def _civil(self, index):
+        return [None if z is None else civil_from_days(z)[index]
+                for z in self._days()]
+
+    @property
+    def year(self):
+        return self._civil(0)
+
+    @property
+    def month(self):
+        return self._civil(1)
+
+    @property
+    def day(self):
+        return self._civil(2)
+
+    @property
+    def weekday(self):
+        """Day of the week with Monday as 0."""
+        return [None if z is None else (z + 3) % 7 for z in self._days()]
+
+    def _time_field(self, unit, modulo):
+        if _NS[self.unit] > _NS[unit]:
+            return [None if t == NAT else 0 for t in self._ticks]
+        per = _NS[unit] // _NS[self.unit]
+        return [None if t == NAT else (t // per) % modulo for t in self._ticks]
+
+    @property
+    def hour(self):
+        return self._time_field('h', 24)
+
+    @property
+    def minute(self):
+        return self._time_field('m', 60)
+
+    @property
+    def second(self):
+        return self._time_field('s', 60)
+
+    def isoformat(self):
+        """ISO 8601 strings at this array's precision."""
+        scale = _NS[self.unit]
+        digits = {'ms': 3, 'us': 6, 'ns': 9}.get(self.unit, 0)
+        out = []
+        for t in self._ticks:
+            if t == NAT:
+                out.append('NaT')
+                continue
+            ns = t * scale
+            days, rem = divmod(ns, _NS['D'])
+            y, m, d = civil_from_days(days)
+            text = '%04d-%02d-%02d' % (y, m, d)
+            if self.unit != 'D':
+                hh, rem = divmod(rem, _NS['h'])
+                mm, rem = divmod(rem, _NS['m'])
+                text += 'T%02d:%02d' % (hh, mm)
+                if self.unit != 'h' and self.unit != 'm':
+                    ss, rem = divmod(rem, _NS['s'])
+                    text += ':%02d' % ss
+                    if digits:
+                        text += '.%s' % str(rem).zfill(9)[:digits]
+            out.append(text)
+        return out
+
+    def __repr__(self):
+        return 'DatetimeArray(%r, unit=%r)' % (self.isoformat(), self.unit)
+
+
+def datetime64(values, unit=None):
+    """Build a `DatetimeArray` from ISO strings or tick counts."""
+    return DatetimeArray(values, unit)
+
+
+def timedelta64(values, unit):
+    """Build a `TimedeltaArray`; a scalar gives a length-1 array."""
+    if isinstance(values, Integral):
+        values = [values]
+    return TimedeltaArray(values, unit)
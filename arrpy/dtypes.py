@@ -0,0 +1,324 @@
+"""Numeric dtypes, type promotion and casting.
+
+Every NumPy numeric dtype from ``bool`` to ``float64`` has a `DType` here.
+`promote_types` implements NumPy's promotion lattice: a signed and an
+unsigned integer promote to a signed integer wide enough for both (or to
+float64 past 64 bits), and an integer mixed with a float promotes to the
+smallest float that holds the integer exactly enough.
+
+`astype` converts the values of a (nested-list) array between dtypes. The
+kernel for every ``(source, target)`` pair is looked up in `_CASTS`, a
+table built once at import time, and each kernel converts a whole flat list
+with C-level operations: ``map`` of a builtin, a bulk ``array``
+conversion, or reinterpretation of packed int64 bytes for wrapping integer
+casts. No cast walks the elements in Python unless wrapping meets an
+integer outside the int64/uint64 range.
+"""
+
+import operator
+import sys
+from array import array
+from itertools import repeat
+
+from .core import ravel, reshape
+from .core import shape as _shape
+from .half import _float16_decode, _float16_encode
+
+_CASTINGS = ('no', 'equiv', 'safe', 'same_kind', 'unsafe')
+
+# Kind order for 'same_kind' casting: b < u < i < f.
+_KIND_ORDER = {'b': 0, 'u': 1, 'i': 2, 'f': 3}
+
+
+class DType:
+    """A numeric dtype: ``kind`` is ``'b'``, ``'i'``, ``'u'`` or ``'f'``."""
+
+    __slots__ = ('name', 'kind', 'itemsize', 'code')
+
+    def __init__(self, name, kind, itemsize, code):
+        self.name = name
+        self.kind = kind
+        self.itemsize = itemsize
+        self.code = code
+
+    @property
+    def bits(self):
+        return 8 * self.itemsize
+
+    @property
+    def min(self):
+        if self.kind == 'i':
+            return -(1 << (self.bits - 1))
+        if self.kind == 'f':
+            return -self.max
+        return 0
+
+    @property
+    def max(self):
+        if self.kind == 'i':
+            return (1 << (self.bits - 1)) - 1
+        if self.kind == 'u':
+            return (1 << self.bits) - 1
+        if self.kind == 'b':
+            return 1
+        return {2: 65504.0, 4: 3.4028234663852886e38, 8: sys.float_info.max}[
+            self.itemsize]
+
+    def __repr__(self):
+        return 'dtype(%r)' % self.name
+
+    def __str__(self):
+        return self.name
+
+
+bool_ = DType('bool', 'b', 1, '?')
+int8 = DType('int8', 'i', 1, 'b')
+int16 = DType('int16', 'i', 2, 'h')
+int32 = DType('int32', 'i', 4, 'i')
+int64 = DType('int64', 'i', 8, 'q')
+uint8 = DType('uint8', 'u', 1, 'B')
+uint16 = DType('uint16', 'u', 2, 'H')
+uint32 = DType('uint32', 'u', 4, 'I')
+uint64 = DType('uint64', 'u', 8, 'Q')
+float16 = DType('float16', 'f', 2, 'e')
+float32 = DType('float32', 'f', 4, 'f')
+float64 = DType('float64', 'f', 8, 'd')
+
+_ALL = (bool_, int8, int16, int32, int64, uint8, uint16, uint32, uint64,
+        float16, float32, float64)
+
+_BY_NAME = {t.name: t for t in _ALL}
+_BY_NAME.update({'%s%d' % (t.kind, t.itemsize): t for t in _ALL if t.kind != 'b'})
+_BY_NAME.update({'b1': bool_, '?': bool_, 'bool_': bool_, 'half': float16,
+                 'single': float32, 'double': float64})
+_BY_NAME.update({bool: bool_, int: int64, float: float64})
+
+
+def dtype(spec):
+    """The `DType` named by ``spec`` (``'int32'``, ``'i4'``, ``float``...)."""
+    if isinstance(spec, DType):
+        return spec
+    try:
+        return _BY_NAME[spec]
+    except (KeyError, TypeError):
+        raise TypeError('data type %r not understood' % (spec,)) from None
+
+
+def _int_of_bits(kind, itemsize):
+    for t in _ALL:
+        if t.kind == kind and t.itemsize == itemsize:
+            return t
+    return None
+
+
+def _float_for_int(t):
+    # Smallest float whose mantissa covers an integer type, capped at float64.
+    return {1: float16, 2: float32}.get(t.itemsize, float64)
+
+
+def _promote(a, b):
+    if a is b:
+        return a
+    if a.kind == 'b':
+        return b
+    if b.kind == 'b':
+        return a
+    if a.kind == b.kind:
+        return a if a.itemsize >= b.itemsize else b
+    if a.kind == 'f' or b.kind == 'f':
+        f, other = (a, b) if a.kind == 'f' else (b, a)
+        need = _float_for_int(other)
+        return f if f.itemsize >= need.itemsize else need
+    s, u = (a, b) if a.kind == 'i' else (b, a)
+    if s.itemsize > u.itemsize:
+        return s
+    return _int_of_bits('i', 2 * u.itemsize) or float64
+
+
+_PROMOTE = {(a.name, b.name): _promote(a, b) for a in _ALL for b in _ALL}
+
+
+def promote_types(a, b):
+    """Smallest dtype both ``a`` and ``b`` cast to safely."""
+    return _PROMOTE[dtype(a).name, dtype(b).name]
+
+
+def result_type(*dtypes):
+    """`promote_types` folded over any number of dtypes."""
+    if not dtypes:
+        raise ValueError('at least one dtype is required')
+    out = dtype(dtypes[0])
+    for t in dtypes[1:]:
+        out = promote_types(out, t)
+    return out
+
+
+def can_cast(from_, to, casting='safe'):
+    """Whether ``from_`` converts to ``to`` under the ``casting`` rule."""
+    a, b = dtype(from_), dtype(to)
+    if casting not in _CASTINGS:
+        raise ValueError('casting must be one of %s' % ', '.join(_CASTINGS))
+    if casting in ('no', 'equiv') or a is b:
+        return a is b
+    if casting == 'unsafe':
+        return True
+    if promote_types(a, b) is b:
+        return True
+    return (casting == 'same_kind'
+            and _KIND_ORDER[a.kind] <= _KIND_ORDER[b.kind])
+
+
+def infer_dtype(values):
+    """bool, int64 or float64 for a flat list of Python scalars."""
+    kinds = set(map(type, values))
+    if kinds <= {bool}:
+        return bool_
+    if kinds <= {bool, int}:
+        return int64
+    return float64
+
+
+# -- kernels: flat list in, flat list of Python scalars out -----------------
+
+def _to_bool(values, dst, saturate):
+    return list(map(bool, values))
+
+
+def _to_float64(values, dst, saturate):
+    return list(map(float, values))
+
+
+def _to_float32(values, dst, saturate):
+    return array('f', map(float, values)).tolist()
+
+
+def _to_float16(values, dst, saturate):
+    values = list(map(float, values))
+    return _float16_decode(_float16_encode(values))
+
+
+def _packed_int64(values):
+    # Values as an int64/uint64 array, or None if some do not fit either.
+    for code in 'qQ':
+        try:
+            return array(code, values)
+        except OverflowError:
+            pass
+    return None
+
+
+def _wrap_int(values, dst):
+    # Two's-complement truncation to ``dst``: keep the low bytes of each
+    # packed 8-byte slot, then reinterpret them as the target type.
+    values = list(values)
+    packed = _packed_int64(values)
+    if packed is None:
+        mask = (1 << dst.bits) - 1
+        half = 1 << (dst.bits - 1) if dst.kind == 'i' else 0
+        return [((v + half) & mask) - half for v in values]
+    if sys.byteorder == 'big':
+        packed.byteswap()
+    raw = packed.tobytes()
+    k = dst.itemsize
+    if k == 8:
+        out = raw
+    else:
+        out = bytearray(len(values) * k)
+        for j in range(k):
+            out[j::k] = raw[j::8]
+    result = array(dst.code)
+    result.frombytes(out)
+    if sys.byteorder == 'big':
+        result.byteswap()
+    return result.tolist()
+
+
+def _clamp_int(values, dst):
+    lo, hi = dst.min, dst.max
+    return list(map(min, map(max, values, repeat(lo)), repeat(hi)))
+
+
+def _int_to_int(values, dst, saturate):
+    values = list(map(int, values))
+    return _clamp_int(values, dst) if saturate else _wrap_int(values, dst)
+
+
+def _float_to_int(values, dst, saturate):
+    values = list(values)
+    if saturate:
+        # NaN becomes 0; the float clamp keeps int() away from +-inf.
+        if not all(map(operator.eq, values, values)):
+            values = [x if x == x else 0.0 for x in values]
+        clamped = map(min, map(max, values, repeat(float(dst.min))),
+                      repeat(float(dst.max)))
+        return _clamp_int(map(int, clamped), dst)
+    try:
+        truncated = list(map(int, values))
+    except (ValueError, OverflowError):
+        raise ValueError('cannot cast NaN or infinity to %s; pass '
+                         'saturate=True to map them into range' % dst.name) from None
+    return _wrap_int(truncated, dst)
+
+
+def _kernel(src, dst):
+    if dst.kind == 'b':
+        return _to_bool
+    if dst.kind == 'f':
+        return {2: _to_float16, 4: _to_float32, 8: _to_float64}[dst.itemsize]
+    return _float_to_int if src.kind == 'f' else _int_to_int
+
+
+_CASTS = {(a.name, b.name): _kernel(a, b) for a in _ALL for b in _ALL}
+
+
+def astype(a, to, casting='unsafe', from_dtype=None, saturate=False):
+    """Convert the values of nested-list array ``a`` to dtype ``to``.
+
+    ``from_dtype`` is the dtype ``a`` holds; by default it is inferred as
+    bool, int64 or float64 from the Python scalar types. ``casting`` follows
+    NumPy (``'no'``, ``'equiv'``, ``'safe'``, ``'same_kind'`` or
+    ``'unsafe'``) and raises `TypeError` when the conversion is not allowed.
+
+    Integer targets wrap on overflow like C by default; with
+    ``saturate=True`` out-of-range values clamp to the target's min/max and
+    NaN becomes 0. Float targets round to nearest, overflowing to infinity.
+    """
+    dims = _shape(a)
+    flat = ravel(a)
+    src = dtype(from_dtype) if from_dtype is not None else infer_dtype(flat)
+    dst = dtype(to)
+    if not can_cast(src, dst, casting):
+        raise TypeError('Cannot cast array data from %r to %r according to '
+                        'the rule %r' % (src, dst, casting))
+    out = _CASTS[src.name, dst.name](flat, dst, saturate)
+    return reshape(out, dims) if dims else out[0]
+
+
+def binary_op(op, a, b, dtype_a=None, dtype_b=None):
+    """Apply ``op`` to flat lists (or scalars) ``a`` and ``b`` after promotion.
+
+    Both operands are cast to their promoted dtype, ``op`` is mapped over
+    them, and the result is cast back into that dtype (so integer results
+    wrap and float32 results round). ``op`` must produce values of the
+    promoted kind, e.g. ``operator.add`` or ``operator.mul``. Returns
+    ``(values, result_dtype)``.
+    """
+    scalar_a = not isinstance(a, (list, tuple))
+    scalar_b = not isinstance(b, (list, tuple))
+    fa = [a] if scalar_a else list(a)
+    fb = [b] if scalar_b else list(b)
+    ta = dtype(dtype_a) if dtype_a is not None else infer_dtype(fa)
+    tb = dtype(dtype_b) if dtype_b is not None else infer_dtype(fb)
+    res = promote_types(ta, tb)
+    fa = _CASTS[ta.name, res.name](fa, res, False)
+    fb = _CASTS[tb.name, res.name](fb, res, False)
+    if scalar_a and not scalar_b:
+        fa = fa * len(fb)
+    elif scalar_b and not scalar_a:
+        fb = fb * len(fa)
+    elif len(fa) != len(fb):
+        raise ValueError('operands have different lengths')
+    out = list(map(op, fa, fb))
+    if res.kind != 'f' or res.itemsize < 8:
+        out = _CASTS[res.name, res.name](out, res, False)
+    return (out[0] if scalar_a and scalar_b else out), res
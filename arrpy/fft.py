@@ -0,0 +1,179 @@
+"""Discrete Fourier transforms.
+
+Power-of-two lengths use an iterative radix-2 transform whose butterflies
+run as whole-slice operations; other lengths go through Bluestein's chirp-z
+algorithm on a padded power-of-two transform. Inputs are sequences (or
+nested lists for `fftn`) of real or complex numbers; outputs are complex.
+A `ComplexArray` input is read straight from its interleaved buffer and
+gives a `ComplexArray` of the same dtype back.
+"""
+
+import cmath
+import math
+import operator
+from functools import lru_cache
+
+from .complexarray import ComplexArray
+from .core import axis_slices, normalize_axis, ravel, reshape
+from .core import shape as _shape
+
+_add = operator.add
+_sub = operator.sub
+_mul = operator.mul
+
+
+def next_fast_len(n):
+    """Smallest power of two >= ``n``, the fastest transform length here."""
+    return 1 if n <= 1 else 1 << (n - 1).bit_length()
+
+
+@lru_cache(maxsize=64)
+def _bitrev(n):
+    bits = n.bit_length() - 1
+    return tuple(int(format(i, '0%db' % bits)[::-1], 2) if bits else 0
+                 for i in range(n))
+
+
+@lru_cache(maxsize=64)
+def _twiddles(size, inverse):
+    sign = 1.0 if inverse else -1.0
+    step = sign * 2.0 * math.pi / size
+    return tuple(cmath.exp(1j * step * k) for k in range(size // 2))
+
+
+def _fft_pow2(x, inverse):
+    n = len(x)
+    a = [x[i] for i in _bitrev(n)]
+    size = 2
+    while size <= n:
+        half = size // 2
+        tw = _twiddles(size, inverse)
+        if half >= n // size:
+            # Few long butterflies: one slice op per block.
+            for start in range(0, n, size):
+                mid = start + half
+                end = start + size
+                lo = a[start:mid]
+                hi = list(map(_mul, a[mid:end], tw))
+                a[start:mid] = map(_add, lo, hi)
+                a[mid:end] = map(_sub, lo, hi)
+        else:
+            # Many short butterflies: one strided slice op per twiddle.
+            for k in range(half):
+                w = tw[k]
+                lo = a[k::size]
+                hi = [w * v for v in a[k + half::size]]
+                a[k::size] = list(map(_add, lo, hi))
+                a[k + half::size] = list(map(_sub, lo, hi))
+        size *= 2
+    return a
+
+
+def _fft_bluestein(x, inverse):
+    n = len(x)
+    sign = 1.0 if inverse else -1.0
+    n2 = 2 * n
+    # k*k mod 2n keeps the chirp angle small and accurate for large k.
+    chirp = [cmath.exp(1j * sign * math.pi * ((k * k) % n2) / n)
+             for k in range(n)]
+    m = next_fast_len(2 * n - 1)
+    a = list(map(_mul, x, chirp)) + [0j] * (m - n)
+    b = [0j] * m
+    b[0] = chirp[0].conjugate()
+    for k in range(1, n):
+        b[k] = b[m - k] = chirp[k].conjugate()
+    fa = _fft_pow2(a, False)
+    fb = _fft_pow2(b, False)
+    conv = _fft_pow2(list(map(_mul, fa, fb)), True)
+    return [c / m * w for c, w in zip(conv[:n], chirp)]
+
+
+def _transform(x, inverse):
+    n = len(x)
+    if n == 0:
+        return []
+    if n & (n - 1) == 0:
+        return _fft_pow2(x, inverse)
+    return _fft_bluestein(x, inverse)
+
+
+def _as_complex(x, n):
+    values = x.tolist() if isinstance(x, ComplexArray) else [complex(v) for v in x]
+    if n is None:
+        return values
+    return values[:n] if len(values) >= n else values + [0j] * (n - len(values))
+
+
+def _like(x, values):
+    if isinstance(x, ComplexArray):
+        return ComplexArray(values, x.dtype)
+    return values
+
+
+def fft(x, n=None):
+    """1-D DFT of ``x``, cropped or zero-padded to ``n`` points."""
+    return _like(x, _transform(_as_complex(x, n), False))
+
+
+def ifft(x, n=None):
+    """Inverse 1-D DFT, normalised by 1/n."""
+    y = _transform(_as_complex(x, n), True)
+    scale = 1.0 / len(y) if y else 1.0
+    return _like(x, [v * scale for v in y])
+
+
+def rfft(x, n=None):
+    """DFT of real input, keeping the ``n // 2 + 1`` non-redundant terms."""
+    y = fft(x, n)
+    return y[:len(y) // 2 + 1]
+
+
+def irfft(x, n=None):
+    """Inverse of `rfft`; ``n`` defaults to ``2 * (len(x) - 1)``."""
+    x = list(x)
+    if n is None:
+        n = 2 * (len(x) - 1)
+    full = [0j] * n
+    for k in range(min(len(x), n // 2 + 1)):
+        full[k] = complex(x[k])
+    for k in range(1, (n + 1) // 2):
+        full[n - k] = full[k].conjugate()
+    return [v.real for v in ifft(full)]
+
+
+def _fftn_flat(flat, dims, axes, inverse):
+    for axis in axes:
+        for s in axis_slices(dims, axis):
+            flat[s] = _transform(flat[s], inverse)
+    if inverse:
+        scale = 1.0 / math.prod(dims[a] for a in axes)
+        flat = [v * scale for v in flat]
+    return flat
+
+
+def _fftn(x, axes, inverse):
+    dims = _shape(x)
+    axes = range(len(dims)) if axes is None else sorted(
+        {normalize_axis(a, len(dims)) for a in axes})
+    flat = [complex(v) for v in ravel(x)]
+    return reshape(_fftn_flat(flat, dims, axes, inverse), dims)
+
+
+def fftn(x, axes=None):
+    """N-D DFT of a nested list over ``axes`` (all axes by default)."""
+    return _fftn(x, axes, False)
+
+
+def ifftn(x, axes=None):
+    """Inverse of `fftn`."""
+    return _fftn(x, axes, True)
+
+
+def fft2(x):
+    """2-D DFT over the last two axes."""
+    return _fftn(x, (-2, -1), False)
+
+
+def ifft2(x):
+    """Inverse of `fft2`."""
+    return _fftn(x, (-2, -1), True)
@@ -0,0 +1,126 @@
+"""Grouped reductions: reduce ``values`` by equal ``keys`` in one pass.
+
+Keys are first turned into dense slot numbers. Small non-negative integer
+keys already are slots and skip hashing entirely; any other hashable keys
+get a slot on first sight through a single dict pass. Every reduction then
+runs as a loop over ``(slot, value)`` pairs into per-slot accumulator
+lists, so no sort or split of the input is needed.
+"""
+
+import math
+from collections import Counter
+from numbers import Integral
+
+from .core import ravel
+
+_OPS = ('sum', 'mean', 'min', 'max', 'count', 'first', 'last', 'var', 'std',
+        'argmin', 'argmax')
+
+
+def _dense_extent(keys):
+    # Number of slots if ``keys`` can index accumulators directly, else None.
+    if not keys or not all(isinstance(k, Integral) and not isinstance(k, bool)
+                           for k in keys):
+        return None
+    lo, hi = min(keys), max(keys)
+    if lo < 0 or hi >= 2 * len(keys) + 1024:
+        return None
+    return hi + 1
+
+
+def _sum(slots, values, size):
+    acc = [0] * size
+    for s, v in zip(slots, values):
+        acc[s] += v
+    return acc
+
+
+def _extreme(slots, values, size, better, want_index):
+    best = [None] * size
+    where = [-1] * size
+    for i, (s, v) in enumerate(zip(slots, values)):
+        b = best[s]
+        if b is None or better(v, b):
+            best[s] = v
+            where[s] = i
+    return where if want_index else best
+
+
+def _var(slots, values, size, counts, ddof):
+    means = [t / c if c else math.nan
+             for t, c in zip(_sum(slots, values, size), counts)]
+    sq = [0.0] * size
+    for s, v in zip(slots, values):
+        d = v - means[s]
+        sq[s] += d * d
+    return [q / (c - ddof) if c - ddof > 0 else math.nan
+            for q, c in zip(sq, counts)]
+
+
+def group_reduce(keys, values=None, op='sum', ddof=0, sort=True):
+    """Reduce ``values`` over groups of equal ``keys``.
+
+    ``op`` is one of sum, mean, min, max, count, first, last, var, std,
+    argmin or argmax; the arg variants return positions in ``values``.
+    ``values`` may be omitted for ``count``. Returns ``(group_keys,
+    results)``, ordered by key when ``sort`` is true and by first
+    appearance otherwise.
+    """
+    if op not in _OPS:
+        raise ValueError('unknown op %r; expected one of %s' % (op, ', '.join(_OPS)))
+    keys = ravel(keys)
+    if values is None:
+        if op != 'count':
+            raise ValueError('values are required for op %r' % op)
+        values = keys
+    else:
+        values = ravel(values)
+        if len(values) != len(keys):
+            raise ValueError('keys and values must have the same length')
+
+    size = _dense_extent(keys)
+    if size is not None:
+        slots = keys
+    else:
+        ids = {}
+        setdefault = ids.setdefault
+        slots = [setdefault(k, len(ids)) for k in keys]
+        size = len(ids)
+
+    tally = Counter(slots)
+    counts = [tally.get(s, 0) for s in range(size)]
+    if op == 'count':
+        result = counts
+    elif op == 'sum':
+        result = _sum(slots, values, size)
+    elif op == 'mean':
+        result = [t / c if c else math.nan
+                  for t, c in zip(_sum(slots, values, size), counts)]
+    elif op in ('min', 'argmin'):
+        result = _extreme(slots, values, size, lambda a, b: a < b, op == 'argmin')
+    elif op in ('max', 'argmax'):
+        result = _extreme(slots, values, size, lambda a, b: a > b, op == 'argmax')
+    elif op == 'first':
+        result = [None] * size
+        for s, v in zip(reversed(slots), reversed(values)):
+            result[s] = v
+    elif op == 'last':
+        result = [None] * size
+        for s, v in zip(slots, values):
+            result[s] = v
+    else:
+        result = _var(slots, values, size, counts, ddof)
+        if op == 'std':
+            result = [math.sqrt(v) for v in result]
+
+    if slots is keys:
+        if sort:
+            present = [k for k in range(size) if counts[k]]
+        else:
+            present = list(dict.fromkeys(keys))
+        return present, [result[k] for k in present]
+    group_keys = list(ids)
+    if sort:
+        order = sorted(range(size), key=group_keys.__getitem__)
+        return [group_keys[i] for i in order], [result[i] for i in order]
+    return group_keys, result
@@ -0,0 +1,190 @@
+"""16-bit floating point storage: IEEE float16 and bfloat16.
+
+`Float16Array` and `BFloat16Array` keep two bytes per element in a
+little-endian buffer, which may be shared (for example an ``mmap`` of an
+embedding table) rather than copied. Whole-array conversions run in C:
+float16 through ``struct``'s ``'e'`` format, bfloat16 by rounding float32
+bit patterns and by interleaving zero bytes to widen them back.
+
+Elementwise arithmetic widens to Python floats, computes, and rounds the
+result back to the storage format once. Reductions (`sum`, `mean`, `dot`)
+accumulate in float64, which is at least as accurate as float32
+accumulation, and return a Python float.
+"""
+
+import math
+import operator
+import struct
+import sys
+from array import array
+from numbers import Integral, Number
+
+from .core import ieee_div
+
+_F16_MAX_ROUND = 65520.0  # smallest magnitude that rounds to inf in float16
+
+
+def _float16_encode(values):
+    n = len(values)
+    try:
+        return struct.pack('<%de' % n, *values)
+    except OverflowError:
+        clamped = [v if -_F16_MAX_ROUND < v < _F16_MAX_ROUND or v != v
+                   else math.copysign(math.inf, v) for v in values]
+        return struct.pack('<%de' % n, *clamped)
+
+
+def _float16_decode(raw):
+    return list(struct.unpack('<%de' % (len(raw) // 2), raw))
+
+
+def _bfloat16_encode(values):
+    bits = array('I', array('f', values).tobytes())
+    out = array('H', [
+        (b >> 16) | 0x40 if b & 0x7FFFFFFF > 0x7F800000  # NaN: keep it quiet
+        else (b + 0x7FFF + ((b >> 16) & 1)) >> 16       # round to nearest even
+        for b in bits])
+    if sys.byteorder == 'big':
+        out.byteswap()
+    return out.tobytes()
+
+
+def _bfloat16_decode(raw):
+    # bfloat16 is the high half of a float32: place each 2-byte value in the
+    # top of a zeroed 4-byte little-endian slot and reinterpret.
+    wide = bytearray(2 * len(raw))
+    wide[2::4] = raw[0::2]
+    wide[3::4] = raw[1::2]
+    return list(struct.unpack('<%df' % (len(raw) // 2), wide))
+
+
+class _HalfArray:
+    _encode = None
+    _decode = None
+
+    def __init__(self, values=()):
+        if isinstance(values, _HalfArray):
+            values = values.tolist()
+        self._bits = memoryview(bytearray(type(self)._encode(
+            [float(v) for v in values]))).cast('H')
+
+    @classmethod
+    def frombuffer(cls, buffer):
+        """Wrap little-endian 16-bit data without copying it."""
+        out = cls.__new__(cls)
+        out._bits = memoryview(buffer).cast('B').cast('H')
+        return out
+
+    def _wrap(self, bits):
+        out = type(self).__new__(type(self))
+        out._bits = bits
+        return out
+
+    def tobytes(self):
+        return self._bits.tobytes()
+
+    @property
+    def nbytes(self):
+        return 2 * len(self._bits)
+
+    def __len__(self):
+        return len(self._bits)
+
+    def tolist(self):
+        return type(self)._decode(self._bits.tobytes())
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            return self._wrap(self._bits[key])
+        if not isinstance(key, Integral):
+            raise TypeError('indices must be integers or slices')
+        n = len(self._bits)
+        if key < 0:
+            key += n
+        if not 0 <= key < n:
+            raise IndexError('index out of range')
+        return type(self)._decode(self._bits[key:key + 1].tobytes())[0]
+
+    def __setitem__(self, key, value):
+        if isinstance(key, slice):
+            idx = range(*key.indices(len(self._bits)))
+            values = [float(v) for v in value]
+            if len(values) != len(idx):
+                raise ValueError('slice assignment changes the array length')
+        else:
+            idx = [key]
+            values = [float(value)]
+        encoded = memoryview(type(self)._encode(values)).cast('H')
+        for i, bits in zip(idx, encoded):
+            self._bits[i] = bits
+
+    def _binary(self, other, op, swap=False):
+        a = self.tolist()
+        if isinstance(other, Number):
+            if swap:
+                values = [op(other, x) for x in a]
+            else:
+                values = [op(x, other) for x in a]
+        else:
+            b = list(other)
+            if len(b) != len(a):
+                raise ValueError('operands have different lengths')
+            values = list(map(op, b, a) if swap else map(op, a, b))
+        return type(self)(values)
+
+    def __add__(self, other):
+        return self._binary(other, operator.add)
+
+    def __sub__(self, other):
+        return self._binary(other, operator.sub)
+
+    def __rsub__(self, other):
+        return self._binary(other, operator.sub, swap=True)
+
+    def __mul__(self, other):
+        return self._binary(other, operator.mul)
+
+    def __truediv__(self, other):
+        return self._binary(other, ieee_div)
+
+    def __rtruediv__(self, other):
+        return self._binary(other, ieee_div, swap=True)
+
+    __radd__ = __add__
+    __rmul__ = __mul__
+
+    def __neg__(self):
+        return type(self)([-x for x in self.tolist()])
+
+    def sum(self):
+        return math.fsum(self.tolist())
+
+    def mean(self):
+        n = len(self._bits)
+        return self.sum() / n if n else math.nan
+
+    def dot(self, other):
+        b = other.tolist() if isinstance(other, _HalfArray) else list(other)
+        if len(b) != len(self._bits):
+            raise ValueError('operands have different lengths')
+        return math.fsum(map(float.__mul__, self.tolist(), map(float, b)))
+
+    def __repr__(self):
+        return '%s(%r)' % (type(self).__name__, self.tolist())
+
+
+class Float16Array(_HalfArray):
+    """IEEE 754 binary16 array (1 sign, 5 exponent, 10 mantissa bits)."""
+
+    _encode = staticmethod(_float16_encode)
+    _decode = staticmethod(_float16_decode)
+
+
+class BFloat16Array(_HalfArray):
+    """bfloat16 array: the top 16 bits of a float32 (8 exponent bits)."""
+
+    _encode = staticmethod(_bfloat16_encode)
+    _decode = staticmethod(_bfloat16_decode)
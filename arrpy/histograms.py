@@ -0,0 +1,207 @@
+"""Histograms, binning and sorted-array search.
+
+Uniform bins map a value to its bin with one multiply, then nudge the
+result by at most one bin so it always agrees with the edge comparisons
+NumPy would make. Explicit edges are located by `bisect`. Counts are
+tallied by `collections.Counter`, whose counting loop runs in C.
+"""
+
+import bisect
+import math
+from collections import Counter
+from itertools import repeat
+from numbers import Integral, Number
+
+from .core import ravel, reshape
+from .core import shape as _shape
+
+
+def _linspace(lo, hi, n):
+    step = (hi - lo) / n
+    edges = [lo + i * step for i in range(n)]
+    edges.append(hi)
+    return edges
+
+
+def _data_range(values, rng):
+    if rng is not None:
+        lo, hi = rng
+        if lo > hi:
+            raise ValueError('max must be larger than min in range parameter')
+    elif values:
+        lo, hi = min(values), max(values)
+    else:
+        lo, hi = 0.0, 1.0
+    if not (math.isfinite(lo) and math.isfinite(hi)):
+        raise ValueError('autodetected range of [%r, %r] is not finite' % (lo, hi))
+    if lo == hi:
+        lo, hi = lo - 0.5, hi + 0.5
+    return float(lo), float(hi)
+
+
+def _edges(values, bins, rng):
+    """Return ``(edges, uniform)`` for an int bin count or explicit edges."""
+    if isinstance(bins, Integral):
+        if bins < 1:
+            raise ValueError('bins must be a positive integer')
+        lo, hi = _data_range(values, rng)
+        return _linspace(lo, hi, int(bins)), True
+    edges = list(bins)
+    if len(edges) < 2:
+        raise ValueError('bins must have at least two edges')
+    if any(b > a for a, b in zip(edges[1:], edges[:-1])):
+        raise ValueError('bins must increase monotonically')
+    return edges, False
+
+
+def _bin_indices(values, edges, uniform):
+    """Bin index per value, or -1 for values outside ``[edges[0], edges[-1]]``."""
+    n = len(edges) - 1
+    lo, hi = edges[0], edges[-1]
+    out = []
+    append = out.append
+    if uniform:
+        norm = n / (hi - lo)
+        for x in values:
+            if not lo <= x <= hi:
+                append(-1)
+                continue
+            i = min(int((x - lo) * norm), n - 1)
+            if x < edges[i]:
+                i -= 1
+            elif i != n - 1 and x >= edges[i + 1]:
+                i += 1
+            append(i)
+    else:
+        find = bisect.bisect_right
+        for x in values:
+            if not lo <= x <= hi:
+                append(-1)
+            else:
+                append(min(find(edges, x) - 1, n - 1))
+    return out
+
+
+def _tally(indices, size, weights):
+    if weights is None:
+        counts = Counter(indices)
+        counts.pop(-1, None)
+        hist = [0] * size
+        for i, c in counts.items():
+            hist[i] = c
+        return hist
+    hist = [0] * size
+    for i, w in zip(indices, weights):
+        if i >= 0:
+            hist[i] += w
+    return hist
+
+
+def histogram(a, bins=10, range=None, weights=None, density=False):
+    """Histogram of the flattened input; returns ``(hist, bin_edges)``."""
+    values = ravel(a)
+    if weights is not None:
+        weights = ravel(weights)
+        if len(weights) != len(values):
+            raise ValueError('weights should have the same shape as a')
+    edges, uniform = _edges(values, bins, range)
+    hist = _tally(_bin_indices(values, edges, uniform), len(edges) - 1, weights)
+    if density:
+        total = sum(hist)
+        hist = [h / (total * (b - a)) if total else math.nan
+                for h, a, b in zip(hist, edges, edges[1:])]
+    return hist, edges
+
+
+def histogramdd(sample, bins=10, range=None, weights=None, density=False):
+    """Multidimensional histogram of ``N`` points with ``D`` coordinates each.
+
+    ``bins`` is an int, a per-dimension list of ints, or a per-dimension list
+    of edge sequences. Returns ``(hist, edges)`` with ``hist`` nested ``D``
+    levels deep.
+    """
+    points = [list(p) for p in sample]
+    if not points:
+        raise ValueError('sample must not be empty')
+    ndim = len(points[0])
+    columns = [list(c) for c in zip(*points)]
+    if isinstance(bins, Integral):
+        bins = [bins] * ndim
+    if len(bins) != ndim:
+        raise ValueError('the dimension of bins must be equal to the dimension '
+                         'of the sample x')
+    ranges = [None] * ndim if range is None else list(range)
+    edges, per_dim = [], []
+    for col, b, r in zip(columns, bins, ranges):
+        e, uniform = _edges(col, b, r)
+        edges.append(e)
+        per_dim.append(_bin_indices(col, e, uniform))
+    dims = tuple(len(e) - 1 for e in edges)
+    strides = [math.prod(dims[d + 1:]) for d, _ in enumerate(dims)]
+    flat_idx = []
+    for idx in zip(*per_dim):
+        if min(idx) < 0:
+            flat_idx.append(-1)
+        else:
+            flat_idx.append(sum(i * s for i, s in zip(idx, strides)))
+    if weights is not None:
+        weights = ravel(weights)
+    hist = _tally(flat_idx, math.prod(dims), weights)
+    if density:
+        total = sum(hist)
+        widths = [[b - a for a, b in zip(e, e[1:])] for e in edges]
+        cells = [1.0]
+        for w in widths:
+            cells = [c * x for c in cells for x in w]
+        hist = [h / (total * c) if total else math.nan
+                for h, c in zip(hist, cells)]
+    return reshape(hist, dims), edges
+
+
+def histogram2d(x, y, bins=10, range=None, weights=None, density=False):
+    """2-D histogram of paired samples; returns ``(H, xedges, yedges)``."""
+    if len(x) != len(y):
+        raise ValueError('x and y must have the same length')
+    if not isinstance(bins, Integral):
+        b = list(bins)
+        # A single edge sequence applies to both axes.
+        if b and isinstance(b[0], Number):
+            bins = [b, b]
+    hist, (xedges, yedges) = histogramdd(zip(x, y), bins, range, weights,
+                                         density)
+    return hist, xedges, yedges
+
+
+def _map_like(x, func):
+    # Apply ``func`` to a scalar or elementwise over a nested list.
+    dims = _shape(x)
+    if not dims:
+        return func(x)
+    return reshape([func(v) for v in ravel(x)], dims)
+
+
+def searchsorted(a, v, side='left', sorter=None):
+    """Insertion points for ``v`` in sorted ``a`` (or ``a`` ordered by ``sorter``)."""
+    if side not in ('left', 'right'):
+        raise ValueError("side must be 'left' or 'right'")
+    a = list(a) if sorter is None else [a[i] for i in sorter]
+    find = bisect.bisect_left if side == 'left' else bisect.bisect_right
+    dims = _shape(v)
+    if not dims:
+        return find(a, v)
+    return reshape(list(map(find, repeat(a), ravel(v))), dims)
+
+
+def digitize(x, bins, right=False):
+    """Index of the bin each value of ``x`` falls into (NumPy semantics)."""
+    bins = list(bins)
+    increasing = all(a <= b for a, b in zip(bins, bins[1:]))
+    decreasing = all(a >= b for a, b in zip(bins, bins[1:]))
+    if not (increasing or decreasing):
+        raise ValueError('bins must be monotonically increasing or decreasing')
+    side = 'left' if right else 'right'
+    if increasing:
+        return searchsorted(bins, x, side)
+    n = len(bins)
+    rev = bins[::-1]
+    return _map_like(x, lambda v: n - searchsorted(rev, v, side))
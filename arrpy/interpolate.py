@@ -0,0 +1,367 @@
+"""1-D and regular-grid interpolation.
+
+Every interpolator here first finds the interval of each query point and
+then evaluates a per-interval formula with whole-list ``map`` passes, so the
+only per-point Python work is the interval search itself, and often not
+even that:
+
+* Sorted queries (the common resampling case) are merged against the knots.
+  One `bisect` per *knot* into the queries finds where each interval's
+  run of queries starts, O(m log n) for m knots, and each run is then
+  evaluated as a slice with that interval's constants. No per-query
+  interval index is built at all.
+* Unsorted queries use ``map(bisect_right, repeat(knots), queries)``, one
+  C-level binary search each, and look their coefficients up by index.
+
+`CubicSpline` solves a tridiagonal system for the knot second derivatives
+(Thomas algorithm), `Akima1DInterpolator` builds local slopes with no
+solve, and both evaluate the resulting cubic of each interval by Horner's
+rule. `RegularGridInterpolator` does multilinear (or nearest) lookups on a
+rectilinear N-d grid, one ``map`` pass per cell corner.
+"""
+
+import bisect
+import math
+import operator
+from itertools import compress, repeat
+
+from .core import ravel, reshape
+from .core import shape as _shape
+
+_add, _sub, _mul = operator.add, operator.sub, operator.mul
+
+
+def _is_sorted(x):
+    # NaN compares false both ways, so NaN queries take the unsorted path.
+    return all(map(operator.eq, x, x)) and all(map(operator.le, x, x[1:]))
+
+
+def _sorted_runs(knots, x):
+    """Where each knot's run starts in ``x``, or None if ``x`` is unsorted.
+
+    ``pos[j]`` is the number of queries below ``knots[j]``, so the queries
+    in ``x[pos[j]:pos[j + 1]]`` all lie in interval ``j``.
+    """
+    if not _is_sorted(x):
+        return None
+    pos = []
+    lo = 0
+    for k in knots:
+        lo = bisect.bisect_left(x, k, lo)
+        pos.append(lo)
+    return pos
+
+
+def _intervals(knots, x):
+    """``bisect_right(knots, v) - 1`` for every ``v`` in ``x``.
+
+    Values below the first knot give -1 and values at or past the last knot
+    give ``len(knots) - 1``.
+    """
+    right = bisect.bisect_right
+    return list(map(_sub, map(right, repeat(knots), x), repeat(1)))
+
+
+def _clamped(js, lo, hi):
+    return list(map(min, map(max, js, repeat(lo)), repeat(hi)))
+
+
+def _where(flags):
+    """Indices whose flag is true."""
+    return compress(range(len(flags)), flags)
+
+
+def _as_flat(x):
+    dims = _shape(x)
+    return ravel(x), dims
+
+
+def _restore(out, dims):
+    if not dims:
+        return out[0]
+    return out if len(dims) == 1 else reshape(out, dims)
+
+
+def interp(x, xp, fp, left=None, right=None):
+    """Piecewise-linear interpolation of ``(xp, fp)`` at ``x``, like NumPy.
+
+    ``xp`` must be increasing. Points below ``xp[0]`` give ``left``
+    (default ``fp[0]``), points above ``xp[-1]`` give ``right`` (default
+    ``fp[-1]``) and NaN gives NaN.
+    """
+    xp, fp = list(xp), list(fp)
+    if len(xp) != len(fp) or not xp:
+        raise ValueError('xp and fp must be non-empty and the same length')
+    x, dims = _as_flat(x)
+    m = len(xp)
+    left = fp[0] if left is None else left
+    right = fp[-1] if right is None else right
+    if m == 1:
+        out = [left if v < xp[0] else right if v > xp[0] else fp[0] for v in x]
+        return _restore(out, dims)
+    dx = list(map(_sub, xp[1:], xp[:-1]))
+    slope = [(b - a) / h if h else 0.0 for a, b, h in zip(fp, fp[1:], dx)]
+    pos = _sorted_runs(xp, x)
+    if pos is not None:
+        out = [left] * pos[0]
+        for j in range(m - 1):
+            chunk = x[pos[j]:pos[j + 1]]
+            out.extend(map(_add, repeat(fp[j]), map(
+                _mul, repeat(slope[j]), map(_sub, chunk, repeat(xp[j])))))
+        at_end = bisect.bisect_right(x, xp[-1], pos[-1])
+        out.extend([fp[-1]] * (at_end - pos[-1]))
+        out.extend([right] * (len(x) - at_end))
+        return _restore(out, dims)
+    raw = _intervals(xp, x)
+    js = _clamped(raw, 0, m - 2)
+    t = map(_sub, x, map(xp.__getitem__, js))
+    out = list(map(_add, map(fp.__getitem__, js),
+                   map(_mul, map(slope.__getitem__, js), t)))
+    for i in _where(list(map(operator.lt, raw, repeat(0)))):
+        out[i] = left
+    for i in _where(list(map(operator.ge, raw, repeat(m - 1)))):
+        out[i] = fp[-1] if x[i] == xp[-1] else right if x[i] == x[i] else math.nan
+    return _restore(out, dims)
+
+
+class _PiecewiseCubic:
+    # Interval i holds c0 + c1*t + c2*t**2 + c3*t**3 with t = x - x[i].
+
+    def _set_hermite(self, x, y, slopes):
+        h = list(map(_sub, x[1:], x[:-1]))
+        d = [(b - a) / hi for a, b, hi in zip(y, y[1:], h)]
+        self.x = x
+        self.c0 = y[:-1]
+        self.c1 = slopes[:-1]
+        self.c2 = [(3 * di - 2 * s0 - s1) / hi
+                   for di, s0, s1, hi in zip(d, slopes, slopes[1:], h)]
+        self.c3 = [(s0 + s1 - 2 * di) / (hi * hi)
+                   for di, s0, s1, hi in zip(d, slopes, slopes[1:], h)]
+
+    def __call__(self, x, nu=0):
+        """Evaluate (the ``nu``-th derivative, 0 to 3) at ``x``.
+
+        Points outside the knots extrapolate with the end intervals.
+        """
+        if not 0 <= nu <= 3:
+            raise ValueError('nu must be between 0 and 3')
+        x, dims = _as_flat(x)
+        coeffs = [self.c0, self.c1, self.c2, self.c3]
+        # Differentiate the local polynomial nu times.
+        for _ in range(nu):
+            coeffs = [[k * c for c in cs] for k, cs in enumerate(coeffs)][1:]
+        last = len(self.x) - 2
+        pos = _sorted_runs(self.x, x)
+        if pos is not None:
+            # Interval 0 also takes the queries left of the knots and the
+            # last interval those right of them.
+            bounds = [0] + pos[1:-1] + [len(x)]
+            out = []
+            for j in range(last + 1):
+                chunk = x[bounds[j]:bounds[j + 1]]
+                if not chunk:
+                    continue
+                t = list(map(_sub, chunk, repeat(self.x[j])))
+                acc = [coeffs[-1][j]] * len(t)
+                for cs in reversed(coeffs[:-1]):
+                    acc = list(map(_add, map(_mul, acc, t), repeat(cs[j])))
+                out.extend(acc)
+            return _restore(out, dims)
+        js = _clamped(_intervals(self.x, x), 0, last)
+        t = list(map(_sub, x, map(self.x.__getitem__, js)))
+        out = list(map(coeffs[-1].__getitem__, js))
+        for cs in reversed(coeffs[:-1]):
+            out = list(map(_add, map(_mul, out, t), map(cs.__getitem__, js)))
+        return _restore(out, dims)
+
+    def derivative(self, nu=1):
+        return lambda x: self(x, nu)
+
+
+def _check_knots(x, y):
+    x, y = list(x), list(y)
+    if len(x) != len(y):
+        raise ValueError('x and y must have the same length')
+    if len(x) < 2:
+        raise ValueError('at least two points are required')
+    if any(b <= a for a, b in zip(x, x[1:])):
+        raise ValueError('x must be strictly increasing')
+    return x, y
+
+
+def _thomas(sub, diag, sup, rhs):
+    """Solve a tridiagonal system; ``sub[0]`` and ``sup[-1]`` are unused."""
+    n = len(diag)
+    c = [0.0] * n
+    d = [0.0] * n
+    c[0] = sup[0] / diag[0] if n > 1 else 0.0
+    d[0] = rhs[0] / diag[0]
+    for i in range(1, n):
+        den = diag[i] - sub[i] * c[i - 1]
+        if i < n - 1:
+            c[i] = sup[i] / den
+        d[i] = (rhs[i] - sub[i] * d[i - 1]) / den
+    for i in range(n - 2, -1, -1):
+        d[i] -= c[i] * d[i + 1]
+    return d
+
+
+class CubicSpline(_PiecewiseCubic):
+    """Twice continuously differentiable cubic spline through ``(x, y)``.
+
+    ``bc_type`` is ``'not-a-knot'`` (the default, as in SciPy: the third
+    derivative is continuous at the second and second-to-last knots) or
+    ``'natural'`` (zero second derivative at both ends).
+    """
+
+    def __init__(self, x, y, bc_type='not-a-knot'):
+        x, y = _check_knots(x, y)
+        if bc_type not in ('not-a-knot', 'natural'):
+            raise ValueError("bc_type must be 'not-a-knot' or 'natural'")
+        n = len(x)
+        h = list(map(_sub, x[1:], x[:-1]))
+        d = [(b - a) / hi for a, b, hi in zip(y, y[1:], h)]
+        if n == 2:
+            M = [0.0, 0.0]
+        elif n == 3 and bc_type == 'not-a-knot':
+            # The two extra conditions force a single parabola.
+            M = [2 * (d[1] - d[0]) / (h[0] + h[1])] * 3
+        else:
+            M = self._second_derivatives(h, d, bc_type)
+        slopes = [di - hi * (2 * m0 + m1) / 6
+                  for di, hi, m0, m1 in zip(d, h, M, M[1:])]
+        slopes.append(d[-1] + h[-1] * (M[-2] + 2 * M[-1]) / 6)
+        self._set_hermite(x, y, slopes)
+
+    @staticmethod
+    def _second_derivatives(h, d, bc_type):
+        # Interior rows: h[i-1] M[i-1] + 2 (h[i-1] + h[i]) M[i] + h[i] M[i+1]
+        # = 6 (d[i] - d[i-1]) for i = 1 .. n-2.
+        sub = h[:-1]
+        diag = [2 * (a + b) for a, b in zip(h, h[1:])]
+        sup = h[1:]
+        rhs = [6 * (b - a) for a, b in zip(d, d[1:])]
+        if bc_type == 'natural':
+            inner = _thomas(sub, diag, sup, rhs)
+            return [0.0] + inner + [0.0]
+        # Not-a-knot: eliminate M[0] and M[-1] with the third-derivative
+        # continuity conditions, keeping the system tridiagonal.
+        h0, h1 = h[0], h[1]
+        diag[0] += h0 + h0 * h0 / h1
+        sup[0] -= h0 * h0 / h1
+        hn, hm = h[-1], h[-2]
+        diag[-1] += hn + hn * hn / hm
+        sub[-1] -= hn * hn / hm
+        inner = _thomas(sub, diag, sup, rhs)
+        m0 = ((h0 + h1) * inner[0] - h0 * inner[1]) / h1
+        mn = ((hn + hm) * inner[-1] - hn * inner[-2]) / hm
+        return [m0] + inner + [mn]
+
+
+class Akima1DInterpolator(_PiecewiseCubic):
+    """Akima's locally weighted cubic interpolant, resistant to overshoot.
+
+    Knot slopes are weighted averages of neighbouring secant slopes, so no
+    linear system is solved and a single outlier only affects nearby
+    intervals.
+    """
+
+    def __init__(self, x, y):
+        x, y = _check_knots(x, y)
+        m = [(b - a) / (xb - xa) for a, b, xa, xb in zip(y, y[1:], x, x[1:])]
+        if len(m) == 1:
+            self._set_hermite(x, y, [m[0], m[0]])
+            return
+        # Two extrapolated secants on each side, as in Akima (1970).
+        m = ([3 * m[0] - 2 * m[1], 2 * m[0] - m[1]] + m
+             + [2 * m[-1] - m[-2], 3 * m[-1] - 2 * m[-2]])
+        slopes = []
+        for i in range(len(x)):
+            w1 = abs(m[i + 3] - m[i + 2])
+            w2 = abs(m[i + 1] - m[i])
+            if w1 + w2 == 0:
+                slopes.append((m[i + 1] + m[i + 2]) / 2)
+            else:
+                slopes.append((w1 * m[i + 1] + w2 * m[i + 2]) / (w1 + w2))
+        self._set_hermite(x, y, slopes)
+
+
+class RegularGridInterpolator:
+    """Interpolation on a rectilinear grid in any number of dimensions.
+
+    ``points`` is one increasing coordinate list per axis and ``values`` a
+    nested list of shape ``(len(points[0]), len(points[1]), ...)``.
+    ``method`` is ``'linear'`` (multilinear) or ``'nearest'``. Out-of-grid
+    queries raise if ``bounds_error`` is true, else give ``fill_value``, or
+    extrapolate linearly when ``fill_value`` is None.
+    """
+
+    def __init__(self, points, values, method='linear', bounds_error=True,
+                 fill_value=math.nan):
+        self.grid = [list(p) for p in points]
+        dims = _shape(values)
+        if dims[:len(self.grid)] != tuple(map(len, self.grid)):
+            raise ValueError('values shape %r does not match the grid' % (dims,))
+        for p in self.grid:
+            if len(p) < 2 or any(b <= a for a, b in zip(p, p[1:])):
+                raise ValueError('grid points must be strictly increasing, '
+                                 'with at least two per axis')
+        if method not in ('linear', 'nearest'):
+            raise ValueError("method must be 'linear' or 'nearest'")
+        self.method = method
+        self.bounds_error = bounds_error
+        self.fill_value = fill_value
+        self.values = ravel(values)
+        self.strides = [math.prod(dims[k + 1:len(self.grid)])
+                        for k in range(len(self.grid))]
+
+    def __call__(self, xi):
+        dims = _shape(xi)
+        ndim = len(self.grid)
+        if not dims or dims[-1] != ndim:
+            raise ValueError('query points must have %d coordinates' % ndim)
+        pts = ravel(xi)
+        n = len(pts) // ndim
+        cols = [pts[k::ndim] for k in range(ndim)]
+        outside = [False] * n
+        idx, frac = [], []
+        for k, (grid, col) in enumerate(zip(self.grid, cols)):
+            lo, hi = grid[0], grid[-1]
+            bad = list(map(operator.or_, map(operator.lt, col, repeat(lo)),
+                           map(operator.gt, col, repeat(hi))))
+            if any(bad):
+                if self.bounds_error:
+                    raise ValueError('one of the requested xi is out of bounds '
+                                     'in dimension %d' % k)
+                outside = list(map(operator.or_, outside, bad))
+            j = _clamped(_intervals(grid, col), 0, len(grid) - 2)
+            g0 = list(map(grid.__getitem__, j))
+            width = map(_sub, map(grid.__getitem__, map(_add, j, repeat(1))), g0)
+            idx.append(j)
+            frac.append(list(map(operator.truediv, map(_sub, col, g0), width)))
+        if self.method == 'nearest':
+            flat = [0] * n
+            for j, f, stride in zip(idx, frac, self.strides):
+                near = map(_add, j, map(operator.gt, f, repeat(0.5)))
+                flat = list(map(_add, flat, map(_mul, near, repeat(stride))))
+            out = list(map(self.values.__getitem__, flat))
+        else:
+            out = [0.0] * n
+            for corner in range(1 << ndim):
+                flat = [0] * n
+                weight = [1.0] * n
+                for k, (j, f, stride) in enumerate(zip(idx, frac, self.strides)):
+                    if corner >> k & 1:
+                        flat = list(map(_add, flat, map(_mul, map(_add, j, repeat(1)),
+                                                         repeat(stride))))
+                        weight = list(map(_mul, weight, f))
+                    else:
+                        flat = list(map(_add, flat, map(_mul, j, repeat(stride))))
+                        weight = list(map(_mul, weight,
+                                          map(_sub, repeat(1.0), f)))
+                out = list(map(_add, out, map(_mul, weight,
+                                              map(self.values.__getitem__, flat))))
+        if self.fill_value is not None:
+            for i in _where(outside):
+                out[i] = self.fill_value
+        return _restore(out, dims[:-1]) if len(dims) > 1 else out[0]
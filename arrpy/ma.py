@@ -0,0 +1,290 @@
+"""Masked arrays with a packed validity bitmap, and NaN-skipping reductions.
+
+`MaskedArray` pairs a list of values with a validity bitmap: bit ``i`` is
+set when element ``i`` is present, the same convention (and, via
+`MaskedArray.validity`, the same little-endian byte layout) as Apache Arrow.
+The bitmap is held as one Python int, so combining the masks of two operands
+is a single ``&`` over all words at once instead of a loop over elements.
+
+Kernels compute every slot, including the nulls, and only the bitmap decides
+which results count. Reductions expand the bitmap into a 0/1 byte string
+with ``format``/``translate`` and feed it to `itertools.compress`, so
+skipping nulls happens in C without a Python-level branch per element.
+
+The ``nan*`` functions apply the same idea to plain nested lists: NaN is the
+only value for which ``x == x`` is false, so
+``compress(lane, map(operator.eq, lane, lane))`` streams the non-NaN values
+without building a mask first.
+"""
+
+import math
+import operator
+from itertools import compress
+from numbers import Number
+
+from .core import axis_slices, normalize_axis, ravel, reshape
+from .core import shape as _shape
+
+_TO_BYTES = bytes.maketrans(b'01', b'\x00\x01')
+_TO_DIGITS = bytes.maketrans(b'\x00\x01', b'01')
+
+
+def _pack(flags):
+    """Bitmap int with bit ``i`` set where ``flags[i]`` is true."""
+    raw = bytes(map(bool, flags))
+    return int(raw[::-1].translate(_TO_DIGITS) or b'0', 2)
+
+
+def _unpack(bits, n):
+    """0/1 byte string of length ``n`` (element ``i`` is bit ``i``)."""
+    if not n:
+        return b''
+    return format(bits, '0%db' % n).encode('ascii')[::-1].translate(_TO_BYTES)
+
+
+def _safe_div(x, y):
+    # Zero divisors are masked by the caller; the slot value is irrelevant.
+    return x / y if y else 0.0
+
+
+class MaskedArray:
+    """1-D values plus a validity bitmap.
+
+    ``mask`` follows NumPy: true marks a missing element. ``None`` entries
+    in ``values`` are missing too. Use `MaskedArray.from_bitmap` to wrap an
+    Arrow-style validity bitmap instead.
+    """
+
+    def __init__(self, values, mask=None, fill_value=0.0):
+        values = list(values.tolist() if isinstance(values, MaskedArray)
+                      else values)
+        n = len(values)
+        present = [v is not None for v in values]
+        if mask is not None:
+            mask = list(mask)
+            if len(mask) != n:
+                raise ValueError('mask length does not match values')
+            present = [p and not m for p, m in zip(present, mask)]
+        self.fill_value = fill_value
+        self._data = [fill_value if v is None else v for v in values]
+        self._valid = _pack(present)
+
+    @classmethod
+    def from_bitmap(cls, values, bitmap):
+        """Wrap ``values`` with Arrow-style little-endian validity bytes."""
+        out = cls.__new__(cls)
+        out.fill_value = 0.0
+        out._data = [out.fill_value if v is None else v for v in values]
+        n = len(out._data)
+        if len(bitmap) * 8 < n:
+            raise ValueError('bitmap is too short for %d values' % n)
+        out._valid = int.from_bytes(bitmap, 'little') & ((1 << n) - 1)
+        return out
+
+    def _new(self, data, valid):
+        out = MaskedArray.__new__(MaskedArray)
+        out._data = data
+        out._valid = valid
+        out.fill_value = self.fill_value
+        return out
+
+    @property
+    def data(self):
+        """Underlying values, including whatever null slots hold."""
+        return self._data
+
+    @property
+    def validity(self):
+        """Packed validity bitmap as little-endian bytes (1 = present)."""
+        return self._valid.to_bytes((len(self._data) + 7) // 8, 'little')
+
+    @property
+    def mask(self):
+        """Per-element ``True`` where the value is missing."""
+        return [not b for b in _unpack(self._valid, len(self._data))]
+
+    def __len__(self):
+        return len(self._data)
+
+    def count(self):
+        """Number of present elements."""
+        return self._valid.bit_count()
+
+    def tolist(self):
+        """Values with ``None`` in the missing slots."""
+        return [v if b else None
+                for v, b in zip(self._data, _unpack(self._valid, len(self._data)))]
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            bits = _unpack(self._valid, len(self._data))
+            return self._new(self._data[key], _pack(bits[key]))
+        if key < 0:
+            key += len(self._data)
+        if not 0 <= key < len(self._data):
+            raise IndexError('index out of range')
+        return self._data[key] if self._valid >> key & 1 else None
+
+    def filled(self, fill_value=None):
+        """Plain list with missing slots replaced by ``fill_value``."""
+        if fill_value is None:
+            fill_value = self.fill_value
+        return [v if b else fill_value
+                for v, b in zip(self._data, _unpack(self._valid, len(self._data)))]
+
+    def compressed(self):
+        """List of the present values only."""
+        return list(compress(self._data, _unpack(self._valid, len(self._data))))
+
+    def _binary(self, other, op, swap=False):
+        a = self._data
+        if isinstance(other, Number):
+            b, valid = [other] * len(a), self._valid
+        else:
+            if isinstance(other, MaskedArray):
+                b, valid = other._data, self._valid & other._valid
+            else:
+                b, valid = list(other), self._valid
+            if len(b) != len(a):
+                raise ValueError('operands have different lengths')
+        if op is _safe_div:
+            valid &= _pack(a if swap else b)
+        return self._new(list(map(op, b, a) if swap else map(op, a, b)), valid)
+
+    def __add__(self, other):
+        return self._binary(other, operator.add)
+
+    def __sub__(self, other):
+        return self._binary(other, operator.sub)
+
+    def __rsub__(self, other):
+        return self._binary(other, operator.sub, swap=True)
+
+    def __mul__(self, other):
+        return self._binary(other, operator.mul)
+
+    def __truediv__(self, other):
+        """Division; results with a zero divisor are masked like NumPy's."""
+        return self._binary(other, _safe_div)
+
+    def __rtruediv__(self, other):
+        return self._binary(other, _safe_div, swap=True)
+
+    __radd__ = __add__
+    __rmul__ = __mul__
+
+    def __neg__(self):
+        return self._new(list(map(operator.neg, self._data)), self._valid)
+
+    def __eq__(self, other):
+        """Elementwise comparison; missing on either side compares as None."""
+        return self._binary(other, operator.eq).tolist()
+
+    __hash__ = None
+
+    def sum(self):
+        return math.fsum(self.compressed())
+
+    def mean(self):
+        """Mean of the present values, or None when all are missing."""
+        n = self.count()
+        return self.sum() / n if n else None
+
+    def var(self, ddof=0):
+        values = self.compressed()
+        n = len(values)
+        if n - ddof <= 0:
+            return None
+        mu = math.fsum(values) / n
+        return math.fsum([(x - mu) * (x - mu) for x in values]) / (n - ddof)
+
+    def std(self, ddof=0):
+        v = self.var(ddof)
+        return None if v is None else math.sqrt(v)
+
+    def min(self):
+        return min(self.compressed(), default=None)
+
+    def max(self):
+        return max(self.compressed(), default=None)
+
+    def __repr__(self):
+        return 'MaskedArray(%r)' % (self.tolist(),)
+
+
+def masked_invalid(values):
+    """Mask NaN and infinite entries of a 1-D sequence."""
+    values = list(values)
+    return MaskedArray.from_bitmap(
+        values, _pack(map(math.isfinite, values)).to_bytes(
+            (len(values) + 7) // 8, 'little'))
+
+
+def _not_nan(lane):
+    return compress(lane, map(operator.eq, lane, lane))
+
+
+def _reduce(a, axis, func):
+    # Reduce every lane along ``axis`` (all elements when None) with func.
+    if axis is None:
+        return func(ravel(a))
+    dims = _shape(a)
+    axis = normalize_axis(axis, len(dims))
+    flat = ravel(a)
+    out = [func(flat[s]) for s in axis_slices(dims, axis)]
+    return reshape(out, dims[:axis] + dims[axis + 1:])
+
+
+def _nanvar_lane(lane, ddof):
+    values = list(_not_nan(lane))
+    n = len(values)
+    if n - ddof <= 0:
+        return math.nan
+    mu = math.fsum(values) / n
+    return math.fsum([(x - mu) * (x - mu) for x in values]) / (n - ddof)
+
+
+def nansum(a, axis=None):
+    """Sum treating NaN as zero."""
+    return _reduce(a, axis, lambda lane: math.fsum(_not_nan(lane)))
+
+
+def nanprod(a, axis=None):
+    """Product treating NaN as one."""
+    return _reduce(a, axis, lambda lane: math.prod(_not_nan(lane), start=1.0))
+
+
+def nancount(a, axis=None):
+    """Number of non-NaN elements."""
+    return _reduce(a, axis, lambda lane: sum(map(operator.eq, lane, lane)))
+
+
+def nanmean(a, axis=None):
+    """Mean ignoring NaN; all-NaN lanes give NaN."""
+    def lane_mean(lane):
+        values = list(_not_nan(lane))
+        return math.fsum(values) / len(values) if values else math.nan
+    return _reduce(a, axis, lane_mean)
+
+
+def nanvar(a, axis=None, ddof=0):
+    """Variance ignoring NaN."""
+    return _reduce(a, axis, lambda lane: _nanvar_lane(lane, ddof))
+
+
+def nanstd(a, axis=None, ddof=0):
+    """Standard deviation ignoring NaN."""
+    return _reduce(a, axis, lambda lane: math.sqrt(_nanvar_lane(lane, ddof)))
+
+
+def nanmin(a, axis=None):
+    """Minimum ignoring NaN; all-NaN lanes give NaN."""
+    return _reduce(a, axis, lambda lane: min(_not_nan(lane), default=math.nan))
+
+
+def nanmax(a, axis=None):
+    """Maximum ignoring NaN; all-NaN lanes give NaN."""
+    return _reduce(a, axis, lambda lane: max(_not_nan(lane), default=math.nan))
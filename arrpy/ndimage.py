@@ -0,0 +1,818 @@
+"""N-dimensional image filters, morphology, resampling and labeling.
+
+Filters follow `scipy.ndimage`: the output has the input's shape and
+``mode`` chooses how the input is extended past its edges (``'reflect'``,
+``'mirror'``, ``'nearest'``, ``'wrap'`` or ``'constant'`` with ``cval``).
+Linear filters with float weights return floats; the rank and morphology
+filters return input values.
+
+Work is organised as passes over 1-D lanes (`core.axis_slices`), so
+each pass reads and writes whole lanes with C-level slice operations:
+
+* Gaussian and other separable kernels run one `correlate1d` pass per
+  axis, one shifted multiply-add per tap. Symmetric kernels add the two
+  mirrored slices first, which halves the multiplies.
+* `uniform_filter` is a running sum: a prefix-sum pass via
+  `itertools.accumulate` and one subtraction, whatever the window size.
+* `grey_erosion` / `grey_dilation` over a box are separable min/max
+  passes. Short windows take ``map(min, *shifted)`` directly; long ones
+  use van Herk/Gil-Werman block prefix and suffix extremes, three
+  comparisons per element regardless of the window.
+* `median_filter` slides a window along the last axis, removing and
+  inserting one window column per step. Integer images spanning at most
+  256 values (uint8 and the like) keep Huang's histogram with a running
+  count below the median, so the median moves a step or two per pixel.
+  Other inputs keep the window sorted and update it by bisection.
+* `binary_erosion` / `binary_dilation` combine one shifted copy of the
+  padded image per structuring element offset in a single ``map`` pass.
+* `zoom` is separable resampling with per-axis index and weight tables
+  built once. `map_coordinates` builds them per dimension for arbitrary
+  points.
+* `label` works on runs of foreground along the last axis rather than on
+  pixels. Each row's runs come from one ``compress`` over its edges, and
+  union-find joins runs that touch runs in earlier rows through the
+  structuring element. A two-pointer sweep finds those overlaps, so the
+  interpreted work scales with the number of runs.
+* `find_objects`, `sum_labels` and `mean_labels` likewise visit runs of
+  equal label, summing each run with one C-level `sum` over its slice.
+
+``workers`` splits the lanes (or output rows) of each pass into blocks run
+on a thread pool, as described in `sparse`. `label` unions within each
+block of rows in parallel and then merges across block boundaries.
+"""
+
+import bisect
+import math
+import operator
+from concurrent.futures import ThreadPoolExecutor
+from itertools import accumulate, chain, compress, product, repeat
+from numbers import Number
+
+from .core import axis_slices, normalize_axis, ravel, reshape
+from .core import shape as _shape
+
+_add, _sub, _mul = operator.add, operator.sub, operator.mul
+
+_MODES = ('reflect', 'mirror', 'nearest', 'wrap', 'constant')
+
+# Windows up to this length take the min/max of shifted slices directly;
+# longer ones use the van Herk/Gil-Werman block scheme.
+_SHIFTED_MAX = 16
+
+# Huang's histogram median applies to integer images whose values span at
+# most _HIST_SPAN and windows of at least _HIST_MIN elements; below that
+# the sorted window was faster (measured 1.6x for 5x5 and 3x for 15x15
+# windows on uint8 data, but slower for 3x3).
+_HIST_SPAN = 256
+_HIST_MIN = 25
+
+
+def _check_mode(mode):
+    if mode not in _MODES:
+        raise ValueError('mode must be one of %s' % ', '.join(map(repr, _MODES)))
+
+
+def _extend(i, n, mode):
+    # Index into a lane of length n for position i outside [0, n).
+    if mode == 'reflect':
+        i %= 2 * n
+        return 2 * n - 1 - i if i >= n else i
+    if mode == 'mirror':
+        if n == 1:
+            return 0
+        i %= 2 * n - 2
+        return 2 * n - 2 - i if i >= n else i
+    if mode == 'wrap':
+        return i % n
+    return min(max(i, 0), n - 1)
+
+
+def _pad(lane, before, after, mode, cval):
+    if mode == 'constant':
+        return [cval] * before + lane + [cval] * after
+    n = len(lane)
+    return ([lane[_extend(i, n, mode)] for i in range(-before, 0)] + lane
+            + [lane[_extend(i, n, mode)] for i in range(n, n + after)])
+
+
+def _per_axis(value, ndim, name):
+    if isinstance(value, Number):
+        return (value,) * ndim
+    value = tuple(value)
+    if len(value) != ndim:
+        raise ValueError('%s must have one entry per axis (%d)' % (name, ndim))
+    return value
+
+
+def _as_flat(input):
+    dims = _shape(input)
+    if not dims:
+        raise ValueError('input must be at least 1-D')
+    return ravel(input), dims
+
+
+def _run(n, workers, kernel):
+    # kernel(lo, hi) handles items lo..hi; blocks run on a thread pool.
+    if workers is None or workers <= 1 or n <= 1:
+        kernel(0, n)
+        return
+    workers = min(workers, n)
+    bounds = [n * p // workers for p in range(workers + 1)]
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        list(pool.map(kernel, bounds[:-1], bounds[1:]))
+
+
+def _map_lanes(flat, dims, axis, func, workers=None, m=None):
+    # Replace every lane along ``axis`` by func(lane), of length m.
+    m = dims[axis] if m is None else m
+    out_dims = dims[:axis] + (m,) + dims[axis + 1:]
+    out = [None] * math.prod(out_dims)
+    if dims[axis] == 0 or m == 0:
+        return out, out_dims
+    src = list(axis_slices(dims, axis))
+    dst = list(axis_slices(out_dims, axis))
+
+    def kernel(lo, hi):
+        for s, d in zip(src[lo:hi], dst[lo:hi]):
+            out[d] = func(flat[s])
+
+    _run(len(src), workers, kernel)
+    return out, out_dims
+
+
+def _pad_all(flat, dims, sizes, mode, cval, centre):
+    # Pad each axis for a window of the given size; returns the new dims too.
+    for axis, w in enumerate(sizes):
+        before = centre(w)
+        flat, dims = _map_lanes(
+            flat, dims, axis,
+            lambda lane, b=before, a=w - 1 - before: _pad(lane, b, a, mode, cval),
+            m=dims[axis] + w - 1)
+    return flat, dims
+
+
+# -- linear filters ----------------------------------------------------------
+
+def _correlate_lane(weights, before, mode, cval):
+    m = len(weights)
+    half = m // 2
+    symmetric = weights == weights[::-1]
+
+    def correlate(lane):
+        n = len(lane)
+        p = _pad(lane, before, m - 1 - before, mode, cval)
+        if symmetric:
+            acc = repeat(0.0)
+            if m % 2:
+                acc = map(_mul, repeat(weights[half]), p[half:half + n])
+            for k in range(half):
+                pair = map(_add, p[k:k + n], p[m - 1 - k:m - 1 - k + n])
+                acc = map(_add, acc, map(_mul, repeat(weights[k]), pair))
+        else:
+            acc = repeat(0.0)
+            for k, w in enumerate(weights):
+                acc = map(_add, acc, map(_mul, repeat(w), p[k:k + n]))
+        return list(acc)
+
+    return correlate
+
+
+def _check_origin(origin, size):
+    if not -(size // 2) <= origin <= (size - 1) // 2:
+        raise ValueError('invalid origin %d for a filter of size %d'
+                         % (origin, size))
+
+
+def correlate1d(input, weights, axis=-1, mode='reflect', cval=0.0, origin=0,
+                workers=None):
+    """Correlate ``input`` with the 1-D ``weights`` along ``axis``."""
+    _check_mode(mode)
+    weights = list(weights)
+    if not weights:
+        raise ValueError('no filter weights given')
+    _check_origin(origin, len(weights))
+    flat, dims = _as_flat(input)
+    axis = normalize_axis(axis, len(dims))
+    func = _correlate_lane(weights, len(weights) // 2 + origin, mode, cval)
+    return reshape(*_map_lanes(flat, dims, axis, func, workers))
+
+
+def convolve1d(input, weights, axis=-1, mode='reflect', cval=0.0, origin=0,
+               workers=None):
+    """Convolve ``input`` with the 1-D ``weights`` along ``axis``."""
+    weights = list(weights)[::-1]
+    origin = -origin - (1 if weights and len(weights) % 2 == 0 else 0)
+    return correlate1d(input, weights, axis, mode, cval, origin, workers)
+
+
+def _gaussian_kernel(sigma, truncate):
+    radius = int(truncate * sigma + 0.5)
+    phi = [math.exp(-0.5 * (x / sigma) ** 2) for x in range(-radius, radius + 1)]
+    total = math.fsum(phi)
+    return [v / total for v in phi]
+
+
+def gaussian_filter1d(input, sigma, axis=-1, mode='reflect', cval=0.0,
+                      truncate=4.0, workers=None):
+    """Gaussian smoothing along one axis, truncated at ``truncate`` sigmas."""
+    if sigma <= 0:
+        raise ValueError('sigma must be positive')
+    return correlate1d(input, _gaussian_kernel(sigma, truncate), axis, mode,
+                       cval, 0, workers)
+
+
+def gaussian_filter(input, sigma, mode='reflect', cval=0.0, truncate=4.0,
+                    workers=None):
+    """Separable Gaussian smoothing; ``sigma`` is a scalar or one per axis.
+
+    Axes with ``sigma == 0`` are left unfiltered.
+    """
+    _check_mode(mode)
+    flat, dims = _as_flat(input)
+    for axis, s in enumerate(_per_axis(sigma, len(dims), 'sigma')):
+        if s < 0:
+            raise ValueError('sigma must be non-negative')
+        if s > 1e-15:
+            weights = _gaussian_kernel(s, truncate)
+            func = _correlate_lane(weights, len(weights) // 2, mode, cval)
+            flat, dims = _map_lanes(flat, dims, axis, func, workers)
+    return reshape(flat, dims)
+
+
+def _uniform_lane(size, before, mode, cval):
+    def box(lane):
+        p = _pad(lane, before, size - 1 - before, mode, cval)
+        sums = list(accumulate(p, initial=0.0))
+        return list(map(_mul, repeat(1.0 / size),
+                        map(_sub, sums[size:], sums[:-size])))
+    return box
+
+
+def uniform_filter1d(input, size, axis=-1, mode='reflect', cval=0.0,
+                     origin=0, workers=None):
+    """Mean over a window of ``size`` along ``axis``, as a running sum."""
+    _check_mode(mode)
+    if size < 1:
+        raise ValueError('incorrect filter size')
+    _check_origin(origin, size)
+    flat, dims = _as_flat(input)
+    axis = normalize_axis(axis, len(dims))
+    func = _uniform_lane(size, size // 2 + origin, mode, cval)
+    return reshape(*_map_lanes(flat, dims, axis, func, workers))
+
+
+def uniform_filter(input, size=3, mode='reflect', cval=0.0, origin=0,
+                   workers=None):
+    """Box blur: a running-sum mean along every axis in turn."""
+    _check_mode(mode)
+    flat, dims = _as_flat(input)
+    sizes = _per_axis(size, len(dims), 'size')
+    origins = _per_axis(origin, len(dims), 'origin')
+    for axis, (w, o) in enumerate(zip(sizes, origins)):
+        if w < 1:
+            raise ValueError('incorrect filter size')
+        _check_origin(o, w)
+        if w > 1:
+            flat, dims = _map_lanes(flat, dims, axis,
+                                    _uniform_lane(w, w // 2 + o, mode, cval),
+                                    workers)
+    return reshape(flat, dims)
+
+
+# -- rank filters ------------------------------------------------------------
+
+def median_filter(input, size=3, mode='reflect', cval=0.0, workers=None):
+    """Median over a box of ``size`` (a scalar or one per axis).
+
+    For an even number of elements the upper of the two middle values is
+    taken, as in SciPy.
+    """
+    _check_mode(mode)
+    flat, dims = _as_flat(input)
+    sizes = _per_axis(size, len(dims), 'size')
+    if min(sizes) < 1:
+        raise ValueError('incorrect filter size')
+    if not flat:
+        return reshape(flat, dims)
+    padded, pdims = _pad_all(flat, dims, sizes, mode, cval, lambda w: w // 2)
+    pstrides = [math.prod(pdims[d + 1:]) for d in range(len(pdims))]
+    width, n = sizes[-1], dims[-1]
+    row_len = pdims[-1]
+    rank = math.prod(sizes) // 2
+    # Offsets of the window's rows relative to the output row's first one.
+    offsets = [sum(map(_mul, k, pstrides)) for k in
+               product(*(range(w) for w in sizes[:-1]))]
+    bases = [sum(map(_mul, i, pstrides)) for i in
+             product(*(range(m) for m in dims[:-1]))]
+    out = [None] * len(flat)
+    low, span = min(padded), max(padded) - min(padded) + 1
+    if (math.prod(sizes) >= _HIST_MIN and span <= _HIST_SPAN
+            and set(map(type, padded)) == {int}):
+        median_row = _histogram_median(width, n, rank, low, span)
+    else:
+        median_row = _sorted_median(width, n, rank)
+
+    def kernel(lo, hi):
+        for r in range(lo, hi):
+            rows = [padded[bases[r] + off:bases[r] + off + row_len]
+                    for off in offsets]
+            out[r * n:(r + 1) * n] = median_row(rows)
+
+    _run(len(bases), workers, kernel)
+    return reshape(out, dims)
+
+
+def _sorted_median(width, n, rank):
+    # Row kernel keeping the window sorted, one bisection per update.
+    insort, locate = bisect.insort, bisect.bisect_left
+
+    def median_row(rows):
+        window = sorted(chain.from_iterable(row[:width] for row in rows))
+        res = [window[rank]]
+        for j in range(n - 1):
+            for row in rows:
+                del window[locate(window, row[j])]
+                insort(window, row[j + width])
+            res.append(window[rank])
+        return res
+    return median_row
+
+
+def _histogram_median(width, n, rank, low, span):
+    # Huang's method: ``below`` counts the window values under bin ``m``,
+    # and ``m`` is the bin holding the element of the given rank.
+    def median_row(rows):
+        hist = [0] * span
+        for v in chain.from_iterable(row[:width] for row in rows):
+            hist[v - low] += 1
+        m = below = 0
+        while below + hist[m] <= rank:
+            below += hist[m]
+            m += 1
+        res = [m + low]
+        for j in range(n - 1):
+            for row in rows:
+                v = row[j] - low
+                hist[v] -= 1
+                if v < m:
+                    below -= 1
+                v = row[j + width] - low
+                hist[v] += 1
+                if v < m:
+                    below += 1
+            while below > rank:
+                m -= 1
+                below -= hist[m]
+            while below + hist[m] <= rank:
+                below += hist[m]
+                m += 1
+            res.append(m + low)
+        return res
+    return median_row
+
+
+def _running_extreme(p, w, n, func):
+    # func (min or max) over every window p[i:i + w], i < n.
+    if w <= _SHIFTED_MAX:
+        return list(map(func, *(p[k:k + n] for k in range(w))))
+    tail = -len(p) % w
+    p = p + [p[-1]] * tail
+    ahead, behind = [], []
+    for b in range(0, len(p), w):
+        block = p[b:b + w]
+        ahead.extend(accumulate(block, func))
+        behind.extend(list(accumulate(reversed(block), func))[::-1])
+    return list(map(func, behind[:n], ahead[w - 1:w - 1 + n]))
+
+
+def _grey(input, size, mode, cval, func, centre, workers):
+    _check_mode(mode)
+    flat, dims = _as_flat(input)
+    for axis, w in enumerate(_per_axis(size, len(dims), 'size')):
+        if w < 1:
+            raise ValueError('incorrect filter size')
+        if w > 1:
+            before = centre(w)
+
+            def lane_func(lane, w=w, before=before):
+                p = _pad(lane, before, w - 1 - before, mode, cval)
+                return _running_extreme(p, w, len(lane), func)
+            flat, dims = _map_lanes(flat, dims, axis, lane_func, workers)
+    return reshape(flat, dims)
+
+
+def grey_erosion(input, size=3, mode='reflect', cval=0.0, workers=None):
+    """Minimum over a flat box of ``size`` (a scalar or one per axis)."""
+    return _grey(input, size, mode, cval, min, lambda w: w // 2, workers)
+
+
+def grey_dilation(input, size=3, mode='reflect', cval=0.0, workers=None):
+    """Maximum over a flat box of ``size``, reflected as SciPy does."""
+    return _grey(input, size, mode, cval, max, lambda w: (w - 1) // 2, workers)
+
+
+# -- binary morphology -------------------------------------------------------
+
+def generate_binary_structure(rank, connectivity):
+    """A ``3**rank`` boolean structuring element.
+
+    Elements within ``connectivity`` unit steps of the centre are True, so
+    ``connectivity=1`` is the cross and ``connectivity=rank`` the full box.
+    """
+    if rank < 1:
+        raise ValueError('rank must be at least 1')
+    connectivity = max(connectivity, 1)
+    cells = [sum(map(abs, k)) <= connectivity
+             for k in product((-1, 0, 1), repeat=rank)]
+    return reshape(cells, (3,) * rank)
+
+
+def _offsets(structure, ndim):
+    # Centred offsets of the True elements of ``structure``.
+    if structure is None:
+        structure = generate_binary_structure(ndim, 1)
+    sdims = _shape(structure)
+    if len(sdims) != ndim:
+        raise ValueError('structure and input must have the same rank')
+    cells = ravel(structure)
+    return [tuple(k - s // 2 for k, s in zip(idx, sdims))
+            for idx, cell in zip(product(*map(range, sdims)), cells) if cell], sdims
+
+
+def _binary(input, structure, iterations, border_value, dilate):
+    flat, dims = _as_flat(input)
+    offsets, sdims = _offsets(structure, len(dims))
+    flat = [1 if v else 0 for v in flat]
+    if not offsets or not flat:
+        return reshape([False] * len(flat), dims)
+    if dilate:
+        offsets = [tuple(-o for o in off) for off in offsets]
+    radius = [max(abs(off[d]) for off in offsets) for d in range(len(dims))]
+    pdims = tuple(n + 2 * r for n, r in zip(dims, radius))
+    pstrides = [math.prod(pdims[d + 1:]) for d in range(len(pdims))]
+    shifts = [sum(map(_mul, off, pstrides)) for off in offsets]
+    lo = sum(map(_mul, radius, pstrides))
+    hi = sum(map(_mul, (r + n - 1 for r, n in zip(radius, dims)), pstrides)) + 1
+    border = 0 if dilate else (1 if border_value else 0)
+    func = max if dilate else min
+    iteration = 0
+    while True:
+        padded, _ = _pad_all(flat, dims, [2 * r + 1 for r in radius], 'constant',
+                             border, lambda w: w // 2)
+        acc = [0] * len(padded)
+        acc[lo:hi] = map(func, *(padded[lo + s:hi + s] for s in shifts))
+        # Crop the border back off, one axis at a time.
+        new = acc
+        for axis, r in enumerate(radius):
+            if r:
+                new, _ = _map_lanes(new, dims[:axis] + pdims[axis:], axis,
+                                    lambda lane, r=r: lane[r:-r], m=dims[axis])
+        iteration += 1
+        done = new == flat
+        flat = new
+        if iteration == iterations or (iterations < 1 and done):
+            break
+    return reshape(list(map(bool, flat)), dims)
+
+
+def binary_erosion(input, structure=None, iterations=1, border_value=0):
+    """Binary erosion; ``structure`` defaults to the cross.
+
+    ``iterations < 1`` repeats until the result stops changing. Pixels past
+    the edge count as ``border_value``.
+    """
+    return _binary(input, structure, iterations, border_value, False)
+
+
+def binary_dilation(input, structure=None, iterations=1):
+    """Binary dilation; ``structure`` defaults to the cross.
+
+    ``iterations < 1`` repeats until the result stops changing.
+    """
+    return _binary(input, structure, iterations, 0, True)
+
+
+# -- resampling --------------------------------------------------------------
+
+def _check_order(order):
+    if order not in (0, 1):
+        raise ValueError('only spline orders 0 (nearest) and 1 (linear) are '
+                         'supported')
+
+
+def _resample_lane(n, m, order):
+    # Lane resampler from n samples onto m, with the end points aligned.
+    scale = (n - 1) / (m - 1) if m > 1 else 0.0
+    coords = [i * scale for i in range(m)]
+    if order == 0:
+        idx = [min(int(c + 0.5), n - 1) for c in coords]
+        return lambda lane: list(map(lane.__getitem__, idx))
+    lo = [min(int(c), max(n - 2, 0)) for c in coords]
+    hi = [min(i + 1, n - 1) for i in lo]
+    frac = list(map(_sub, coords, lo))
+    keep = [1.0 - f for f in frac]
+    return lambda lane: list(map(
+        _add, map(_mul, keep, map(lane.__getitem__, lo)),
+        map(_mul, frac, map(lane.__getitem__, hi))))
+
+
+def zoom(input, zoom, order=1, workers=None):
+    """Resample ``input`` by ``zoom`` (a scalar or one factor per axis).
+
+    Each axis of length n becomes ``round(n * zoom)``, with the first and
+    last samples kept in place. ``order`` 0 is nearest-neighbour and 1 is
+    linear, applied separably. SciPy's default cubic spline is not
+    provided.
+    """
+    _check_order(order)
+    flat, dims = _as_flat(input)
+    for axis, z in enumerate(_per_axis(zoom, len(dims), 'zoom')):
+        n, m = dims[axis], int(round(dims[axis] * z))
+        if m < 1:
+            raise ValueError('zoom would leave an empty axis')
+        if n != m:
+            flat, dims = _map_lanes(flat, dims, axis,
+                                    _resample_lane(n, m, order), workers, m)
+    return reshape(flat, dims)
+
+
+def _axis_terms(coords, n, order, mode):
+    # (indices, weights) pairs along one axis and per-point outside flags.
+    if mode == 'constant':
+        outside = [c < 0 or c > n - 1 for c in coords]
+
+        def ext(i):
+            return min(max(i, 0), n - 1)
+    else:
+        outside = None
+
+        def ext(i):
+            return i if 0 <= i < n else _extend(i, n, mode)
+    if order == 0:
+        return [([ext(math.floor(c + 0.5)) for c in coords], None)], outside
+    lo = list(map(math.floor, coords))
+    frac = list(map(_sub, coords, lo))
+    return [([ext(i) for i in lo], [1.0 - f for f in frac]),
+            ([ext(i + 1) for i in lo], frac)], outside
+
+
+def map_coordinates(input, coordinates, order=1, mode='constant', cval=0.0):
+    """Sample ``input`` at fractional ``coordinates``.
+
+    ``coordinates`` has one leading entry per input axis; the result has
+    the shape of the remaining axes. With ``mode='constant'`` points
+    outside the input get ``cval``.
+    """
+    _check_order(order)
+    _check_mode(mode)
+    flat, dims = _as_flat(input)
+    cdims = _shape(coordinates)
+    if not cdims or cdims[0] != len(dims):
+        raise ValueError('coordinates must have one entry per input axis')
+    out_dims = cdims[1:]
+    npts = math.prod(out_dims)
+    cflat = ravel(coordinates)
+    strides = [math.prod(dims[d + 1:]) for d in range(len(dims))]
+    terms = [([0] * npts, None)]
+    outside = [False] * npts
+    for d, n in enumerate(dims):
+        axis_terms, out_d = _axis_terms(cflat[d * npts:(d + 1) * npts], n,
+                                        order, mode)
+        if out_d is not None:
+            outside = list(map(operator.or_, outside, out_d))
+        new_terms = []
+        for idx, w in terms:
+            for idx_d, w_d in axis_terms:
+                idx_new = list(map(_add, idx, map(_mul, idx_d, repeat(strides[d]))))
+                if w is None or w_d is None:
+                    w_new = w_d if w is None else w
+                else:
+                    w_new = list(map(_mul, w, w_d))
+                new_terms.append((idx_new, w_new))
+        terms = new_terms
+    acc = repeat(0.0)
+    for idx, w in terms:
+        values = map(flat.__getitem__, idx)
+        acc = map(_add, acc, values if w is None else map(_mul, w, values))
+    out = list(acc)
+    for i, off in enumerate(outside):
+        if off:
+            out[i] = cval
+    if not out_dims:
+        return out[0]
+    return reshape(out, out_dims)
+
+
+# -- labeling and region measurements ---------------------------------------
+
+def _row_runs(row, single):
+    # Starts and ends of the runs of nonzero values in ``row``.
+    b = list(map(bool, row))
+    edges = list(compress(range(len(b) + 1),
+                          map(operator.ne, chain((False,), b), chain(b, (False,)))))
+    starts, ends = edges[0::2], edges[1::2]
+    if single:
+        starts = [i for s, e in zip(starts, ends) for i in range(s, e)]
+        ends = [i + 1 for i in starts]
+    return starts, ends
+
+
+def _shift_spans(shifts):
+    # Group sorted column shifts into contiguous (lo, hi) spans.
+    spans = []
+    for e in shifts:
+        if spans and spans[-1][1] == e - 1:
+            spans[-1] = (spans[-1][0], e)
+        else:
+            spans.append((e, e))
+    return spans
+
+
+def label(input, structure=None, workers=None):
+    """Label the connected components of the nonzero elements of ``input``.
+
+    ``structure`` is a symmetric ``3**ndim`` connectivity element and
+    defaults to the cross from `generate_binary_structure`. Returns
+    ``(labels, num_features)``; components are numbered from 1 in the order
+    their first element appears in a row-major scan and background is 0.
+    """
+    flat, dims = _as_flat(input)
+    ndim = len(dims)
+    if structure is None:
+        structure = generate_binary_structure(ndim, 1)
+    if _shape(structure) != (3,) * ndim:
+        raise ValueError('structure dimensions must be equal to 3')
+    cells = [bool(c) for c in ravel(structure)]
+    if cells != cells[::-1]:
+        raise ValueError('structure must be symmetric')
+    # Columns within a row only connect if the element links them.
+    single = not cells[len(cells) // 2 + 1]
+    # Earlier rows a row can touch, with the column shifts allowed for each.
+    neighbours = {}
+    for idx, cell in zip(product((-1, 0, 1), repeat=ndim), cells):
+        if cell and idx[:-1] < (0,) * (ndim - 1):
+            neighbours.setdefault(idx[:-1], []).append(idx[-1])
+    neighbours = [(lead, _shift_spans(shifts))
+                  for lead, shifts in neighbours.items()]
+
+    n = dims[-1]
+    lead_dims = dims[:-1]
+    rstrides = [math.prod(lead_dims[d + 1:]) for d in range(ndim - 1)]
+    rows = list(product(*map(range, lead_dims)))
+    runs = [_row_runs(flat[r * n:(r + 1) * n], single) for r in range(len(rows))]
+    first = list(accumulate((len(st) for st, _ in runs), initial=0))
+    parent = list(range(first[-1]))
+
+    def find(x):
+        while parent[x] != x:
+            parent[x] = parent[parent[x]]
+            x = parent[x]
+        return x
+
+    def link(r, q, spans):
+        # Union the runs of row r with the touching runs of row q.
+        a_starts, a_ends = runs[r]
+        b_starts, b_ends = runs[q]
+        for lo, hi in spans:
+            i = j = 0
+            while i < len(a_starts) and j < len(b_starts):
+                start, end = a_starts[i] + lo, a_ends[i] + hi
+                if end <= b_starts[j]:
+                    i += 1
+                    continue
+                if b_ends[j] > start:
+                    x, y = find(first[r] + i), find(first[q] + j)
+                    if x != y:
+                        parent[max(x, y)] = min(x, y)
+                if end <= b_ends[j]:
+                    i += 1
+                else:
+                    j += 1
+
+    def targets(r):
+        idx = rows[r]
+        for lead, spans in neighbours:
+            if all(0 <= i + d < m for i, d, m in zip(idx, lead, lead_dims)):
+                yield r + sum(map(_mul, lead, rstrides)), spans
+
+    deferred = []
+
+    def kernel(lo, hi):
+        for r in range(lo, hi):
+            for q, spans in targets(r):
+                if q >= lo:
+                    link(r, q, spans)
+                else:
+                    deferred.append((r, q, spans))
+
+    _run(len(rows), workers, kernel)
+    for r, q, spans in deferred:
+        link(r, q, spans)
+
+    # Roots are the smallest run id of each component, so one pass in run
+    # order numbers components by first appearance.
+    labels = [0] * len(parent)
+    count = 0
+    for i in range(len(parent)):
+        root = find(i)
+        if root == i:
+            count += 1
+            labels[i] = count
+        else:
+            labels[i] = labels[root]
+    out = [0] * len(flat)
+    for r, (starts, ends) in enumerate(runs):
+        base = r * n
+        for k, (s, e) in enumerate(zip(starts, ends), first[r]):
+            out[base + s:base + e] = repeat(labels[k], e - s)
+    return reshape(out, dims), count
+
+
+def _label_runs(flat, width):
+    # (start, end, value) for every run of equal values, split at multiples
+    # of ``width``.
+    cuts = set(compress(range(1, len(flat)),
+                        map(operator.ne, flat[1:], flat[:-1])))
+    cuts.update(range(width, len(flat), width))
+    starts = [0] + sorted(cuts) if flat else []
+    ends = starts[1:] + [len(flat)]
+    return zip(starts, ends, map(flat.__getitem__, starts))
+
+
+def find_objects(input, max_label=0):
+    """Bounding boxes of the labels in an integer array.
+
+    Returns a list whose entry ``i`` is a tuple of slices covering label
+    ``i + 1``, or None if that label does not occur. The list runs to
+    ``max_label`` if given, else to the largest label present.
+    """
+    flat, dims = _as_flat(input)
+    n = dims[-1]
+    strides = [math.prod(dims[d + 1:-1]) for d in range(len(dims) - 1)]
+    boxes = {}
+    for s, e, lab in _label_runs(flat, n):
+        if lab <= 0 or (max_label and lab > max_label):
+            continue
+        r, col = divmod(s, n)
+        idx = []
+        for stride in strides:
+            i, r = divmod(r, stride)
+            idx.append(i)
+        lo, hi = idx + [col], idx + [col + e - s - 1]
+        box = boxes.get(lab)
+        if box is None:
+            boxes[lab] = [lo, hi]
+        else:
+            box[0] = list(map(min, box[0], lo))
+            box[1] = list(map(max, box[1], hi))
+    size = max_label or max(boxes, default=0)
+    out = [None] * size
+    for lab, (lo, hi) in boxes.items():
+        out[lab - 1] = tuple(slice(a, b + 1) for a, b in zip(lo, hi))
+    return out
+
+
+def _label_totals(input, labels):
+    # Per-label (sum, count) over the runs of equal label.
+    values, dims = _as_flat(input)
+    keys = ravel(labels)
+    if _shape(labels) != dims:
+        raise ValueError('input and labels must have the same shape')
+    sums, counts = {}, {}
+    for s, e, lab in _label_runs(keys, len(keys) or 1):
+        sums[lab] = sums.get(lab, 0) + sum(values[s:e])
+        counts[lab] = counts.get(lab, 0) + e - s
+    return sums, counts
+
+
+def _measure(input, labels, index, func):
+    if labels is None:
+        values, _ = _as_flat(input)
+        return func(sum(values), len(values))
+    sums, counts = _label_totals(input, labels)
+    if index is None:
+        picked = [lab for lab in sums if lab > 0]
+        return func(sum(sums[lab] for lab in picked),
+                    sum(counts[lab] for lab in picked))
+    if isinstance(index, Number):
+        return func(sums.get(index, 0), counts.get(index, 0))
+    return [func(sums.get(lab, 0), counts.get(lab, 0)) for lab in index]
+
+
+def sum_labels(input, labels=None, index=None):
+    """Sum of ``input`` over each label in ``index``.
+
+    Without ``labels`` the whole array is summed; without ``index`` every
+    element with a positive label is. A scalar ``index`` gives a scalar
+    and a sequence gives a list.
+    """
+    return _measure(input, labels, index, lambda total, count: total)
+
+
+def mean_labels(input, labels=None, index=None):
+    """Mean of ``input`` over each label in ``index``; see `sum_labels`.
+
+    Labels with no elements give NaN.
+    """
+    return _measure(input, labels, index,
+                    lambda total, count: total / count if count else math.nan)
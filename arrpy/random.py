@@ -0,0 +1,414 @@
+"""Random sampling.
+
+`Generator` wraps a Mersenne Twister stream and draws from the common
+distributions. Every sampler takes a ``size`` argument: ``None`` returns a
+scalar, an int or tuple returns a nested list of that shape.
+"""
+
+import heapq
+import math
+import random as _random
+from numbers import Integral
+
+from .core import reshape
+
+
+def _as_shape(size):
+    if size is None:
+        return None
+    if isinstance(size, Integral):
+        return (int(size),)
+    return tuple(int(s) for s in size)
+
+
+def _cholesky_psd(cov):
+    # Lower Cholesky factor that tolerates positive semi-definite input by
+    # zeroing columns whose pivot vanishes.
+    n = len(cov)
+    scale = max((abs(cov[i][i]) for i in range(n)), default=0.0)
+    tol = 1e-12 * scale
+    L = [[0.0] * n for _ in range(n)]
+    for j in range(n):
+        d = cov[j][j] - sum(L[j][k] * L[j][k] for k in range(j))
+        if d < -1e-8 * max(scale, 1.0):
+            raise ValueError('covariance is not positive semi-definite')
+        if d <= tol:
+            continue
+        d = math.sqrt(d)
+        L[j][j] = d
+        for i in range(j + 1, n):
+            s = cov[i][j] - sum(L[i][k] * L[j][k] for k in range(j))
+            L[i][j] = s / d
+    return L
+
+
+class AliasTable:
+    """Walker/Vose alias table for O(1) weighted sampling.
+
+    Building the table is O(n); each draw afterwards costs one uniform and
+    one comparison. Pass a table as ``p`` to `Generator.choice` to reuse it
+    across calls instead of rebuilding it from the weights every time.
+    """
+
+    __slots__ = ('n', 'prob', 'alias')
+
+    def __init__(self, weights):
+        weights = [float(w) for w in weights]
+        n = len(weights)
+        if n == 0:
+            raise ValueError('weights must be non-empty')
+        if any(w < 0 or w != w for w in weights):
+            raise ValueError('weights must be non-negative')
+        total = math.fsum(weights)
+        if total <= 0:
+            raise ValueError('weights must not all be zero')
+        scaled = [w * n / total for w in weights]
+        prob = [1.0] * n
+        alias = list(range(n))
+        small = [i for i, s in enumerate(scaled) if s < 1.0]
+        large = [i for i, s in enumerate(scaled) if s >= 1.0]
+        while small and large:
+            s = small.pop()
+            l = large.pop()
+            prob[s] = scaled[s]
+            alias[s] = l
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0
+            (small if scaled[l] < 1.0 else large).append(l)
+        self.n = n
+        self.prob = prob
+        self.alias = alias
+
+    def __len__(self):
+        return self.n
+
+    def sample(self, rng, count):
+        """Draw ``count`` indices using the ``random()`` method of ``rng``."""
+        rnd = rng.random
+        n, prob, alias = self.n, self.prob, self.alias
+        out = []
+        append = out.append
+        for _ in range(count):
+            u = rnd() * n
+            i = int(u)
+            append(i if u - i < prob[i] else alias[i])
+        return out
+
+
+class Generator:
+    """Source of random samples from a seeded Mersenne Twister stream."""
+
+    def __init__(self, seed=None):
+        self._rng = _random.Random(seed)
+
+    def _fill(self, draw, size):
+        dims = _as_shape(size)
+        if dims is None:
+            return draw()
+        return reshape([draw() for _ in range(math.prod(dims))], dims)
+
+    # -- continuous ------------------------------------------------------
+
+    def random(self, size=None):
+        return self._fill(self._rng.random, size)
+
+    def uniform(self, low=0.0, high=1.0, size=None):
+        rnd = self._rng.random
+        span = high - low
+        return self._fill(lambda: low + span * rnd(), size)
+
+    def standard_normal(self, size=None):
+        gauss = self._rng.gauss
+        return self._fill(lambda: gauss(0.0, 1.0), size)
+
+    def normal(self, loc=0.0, scale=1.0, size=None):
+        if scale < 0:
+            raise ValueError('scale < 0')
+        gauss = self._rng.gauss
+        return self._fill(lambda: gauss(loc, scale), size)
+
+    def exponential(self, scale=1.0, size=None):
+        if scale < 0:
+            raise ValueError('scale < 0')
+        rnd = self._rng.random
+        return self._fill(lambda: -scale * math.log(1.0 - rnd()), size)
+
+    def _standard_gamma(self, k):
+        # Marsaglia & Tsang (2000); boosted by U**(1/k) for k < 1.
+        rnd = self._rng.random
+        gauss = self._rng.gauss
+        if k == 0.0:
+            return 0.0
+        if k < 1.0:
+            return self._standard_gamma(k + 1.0) * rnd() ** (1.0 / k)
+        d = k - 1.0 / 3.0
+        c = 1.0 / math.sqrt(9.0 * d)
+        while True:
+            x = gauss(0.0, 1.0)
+            v = 1.0 + c * x
+            if v <= 0.0:
+                continue
+            v = v * v * v
+            u = rnd()
+            x2 = x * x
+            if u < 1.0 - 0.0331 * x2 * x2:
+                return d * v
+            if math.log(u) < 0.5 * x2 + d * (1.0 - v + math.log(v)):
+                return d * v
+
+    def standard_gamma(self, shape, size=None):
+        if shape < 0:
+            raise ValueError('shape < 0')
+        return self._fill(lambda: self._standard_gamma(shape), size)
+
+    def gamma(self, shape, scale=1.0, size=None):
+        if shape < 0:
+            raise ValueError('shape < 0')
+        if scale < 0:
+            raise ValueError('scale < 0')
+        return self._fill(lambda: scale * self._standard_gamma(shape), size)
+
+    def beta(self, a, b, size=None):
+        if a <= 0 or b <= 0:
+            raise ValueError('a <= 0 or b <= 0')
+
+        def draw():
+            while True:
+                x = self._standard_gamma(a)
+                y = self._standard_gamma(b)
+                if x + y > 0.0:
+                    return x / (x + y)
+
+        return self._fill(draw, size)
+
+    # -- discrete --------------------------------------------------------
+
+    def integers(self, low, high=None, size=None):
+        """Uniform integers from ``[low, high)`` (``[0, low)`` if no high)."""
+        if high is None:
+            low, high = 0, low
+        if high <= low:
+            raise ValueError('low >= high')
+        randrange = self._rng.randrange
+        return self._fill(lambda: randrange(low, high), size)
+
+    def _binomial_inversion(self, n, p):
+        rnd = self._rng.random
+        q = 1.0 - p
+        qn = math.exp(n * math.log(q))
+        mean = n * p
+        bound = min(n, mean + 10.0 * math.sqrt(mean * q + 1.0))
+        x = 0
+        px = qn
+        u = rnd()
+        while u > px:
+            x += 1
+            if x > bound:
+                x = 0
+                px = qn
+                u = rnd()
+            else:
+                u -= px
+                px = ((n - x + 1) * p * px) / (x * q)
+        return x
+
+    def _binomial_btrs(self, n, p):
+        # Hormann's transformed rejection with squeeze (BTRS), for n*p >= 10.
+        rnd = self._rng.random
+        lgamma = math.lgamma
+        q = 1.0 - p
+        spq = math.sqrt(n * p * q)
+        b = 1.15 + 2.53 * spq
+        a = -0.0873 + 0.0248 * b + 0.01 * p
+        c = n * p + 0.5
+        v_r = 0.92 - 4.2 / b
+        alpha = (2.83 + 5.1 / b) * spq
+        lpq = math.log(p / q)
+        m = math.floor((n + 1) * p)
+        h = lgamma(m + 1.0) + lgamma(n - m + 1.0)
+        while True:
+            u = rnd() - 0.5
+            v = rnd()
+            us = 0.5 - abs(u)
+            if us <= 0.0:
+                continue
+            k = math.floor((2.0 * a / us + b) * u + c)
+            if k < 0 or k > n:
+                continue
+            if us >= 0.07 and v <= v_r:
+                return k
+            v = math.log(v * alpha / (a / (us * us) + b))
+            if v <= h - lgamma(k + 1.0) - lgamma(n - k + 1.0) + (k - m) * lpq:
+                return k
+
+    def _binomial(self, n, p):
+        if n == 0 or p == 0.0:
+            return 0
+        if p == 1.0:
+            return n
+        if p > 0.5:
+            return n - self._binomial(n, 1.0 - p)
+        if n * p < 10.0:
+            return self._binomial_inversion(n, p)
+        return self._binomial_btrs(n, p)
+
+    def binomial(self, n, p, size=None):
+        if n < 0 or int(n) != n:
+            raise ValueError('n must be a non-negative integer')
+        if not 0.0 <= p <= 1.0:
+            raise ValueError('p must be in [0, 1]')
+        n = int(n)
+        return self._fill(lambda: self._binomial(n, p), size)
+
+    def _poisson_ptrs(self, lam):
+        # Hormann's transformed rejection (PTRS), for lam >= 10.
+        rnd = self._rng.random
+        slam = math.sqrt(lam)
+        loglam = math.log(lam)
+        b = 0.931 + 2.53 * slam
+        a = -0.059 + 0.02483 * b
+        invalpha = 1.1239 + 1.1328 / (b - 3.4)
+        vr = 0.9277 - 3.6224 / (b - 2.0)
+        while True:
+            u = rnd() - 0.5
+            v = rnd()
+            us = 0.5 - abs(u)
+            if us <= 0.0:
+                continue
+            k = math.floor((2.0 * a / us + b) * u + lam + 0.43)
+            if us >= 0.07 and v <= vr:
+                return k
+            if k < 0 or (us < 0.013 and v > us):
+                continue
+            if (math.log(v) + math.log(invalpha) - math.log(a / (us * us) + b)
+                    <= -lam + k * loglam - math.lgamma(k + 1.0)):
+                return k
+
+    def _poisson(self, lam):
+        if lam >= 10.0:
+            return self._poisson_ptrs(lam)
+        if lam == 0.0:
+            return 0
+        rnd = self._rng.random
+        enlam = math.exp(-lam)
+        x = 0
+        prod = 1.0
+        while True:
+            prod *= rnd()
+            if prod <= enlam:
+                return x
+            x += 1
+
+    def poisson(self, lam=1.0, size=None):
+        if lam < 0 or lam != lam:
+            raise ValueError('lam must be non-negative')
+        return self._fill(lambda: self._poisson(lam), size)
+
+    def multinomial(self, n, pvals, size=None):
+        """Counts over ``len(pvals)`` categories; appends that axis to size."""
+        pvals = [float(p) for p in pvals]
+        if any(p < 0.0 or p > 1.0 for p in pvals):
+            raise ValueError('pvals must be in [0, 1]')
+        if math.fsum(pvals[:-1]) > 1.0 + 1e-12:
+            raise ValueError('sum(pvals[:-1]) > 1.0')
+        k = len(pvals)
+
+        def draw():
+            out = [0] * k
+            remaining = n
+            rest = 1.0
+            for j in range(k - 1):
+                if remaining <= 0:
+                    break
+                pj = pvals[j] / rest if rest > 0.0 else 1.0
+                x = self._binomial(remaining, min(max(pj, 0.0), 1.0))
+                out[j] = x
+                remaining -= x
+                rest -= pvals[j]
+            out[k - 1] += remaining
+            return out
+
+        return self._fill(draw, size)
+
+    def multivariate_normal(self, mean, cov, size=None):
+        """Draw ``mean + L z`` with ``L`` the Cholesky factor of ``cov``."""
+        mean = [float(m) for m in mean]
+        d = len(mean)
+        if len(cov) != d or any(len(row) != d for row in cov):
+            raise ValueError('cov must be a square matrix matching mean')
+        L = _cholesky_psd(cov)
+        gauss = self._rng.gauss
+
+        def draw():
+            z = [gauss(0.0, 1.0) for _ in range(d)]
+            return [mean[i] + sum(L[i][k] * z[k] for k in range(i + 1))
+                    for i in range(d)]
+
+        return self._fill(draw, size)
+
+    # -- permutations ----------------------------------------------------
+
+    def choice(self, a, size=None, replace=True, p=None):
+        """Sample from ``a`` (a sequence, or ``range(a)`` for an int).
+
+        ``p`` may be a sequence of weights or a prebuilt `AliasTable`. With
+        a table, weighted sampling with replacement has no per-call setup.
+        """
+        pop = range(int(a)) if isinstance(a, Integral) else a
+        n = len(pop)
+        dims = _as_shape(size)
+        count = 1 if dims is None else math.prod(dims)
+        if p is not None and not isinstance(p, AliasTable) and len(p) != n:
+            raise ValueError('a and p must have the same size')
+        if n == 0 and count:
+            raise ValueError('cannot take a sample from an empty population')
+
+        if replace:
+            if p is None:
+                randrange = self._rng.randrange
+                idx = [randrange(n) for _ in range(count)]
+            else:
+                table = p if isinstance(p, AliasTable) else AliasTable(p)
+                if table.n != n:
+                    raise ValueError('a and p must have the same size')
+                idx = table.sample(self._rng, count)
+        else:
+            if count > n:
+                raise ValueError('cannot take a larger sample than '
+                                 'population when replace=False')
+            if p is None:
+                idx = self._rng.sample(range(n), count)
+            else:
+                if isinstance(p, AliasTable):
+                    raise ValueError('replace=False needs explicit weights')
+                # Efraimidis-Spirakis: keep the largest u**(1/w) keys, taken
+                # as log(u) / w so that small weights do not underflow to 0.
+                rnd = self._rng.random
+                log = math.log
+                keyed = [(log(1.0 - rnd()) / w, i)
+                         for i, w in enumerate(p) if w > 0]
+                if len(keyed) < count:
+                    raise ValueError('fewer non-zero entries in p than size')
+                idx = [i for _, i in heapq.nlargest(count, keyed)]
+
+        out = [pop[i] for i in idx]
+        return out[0] if dims is None else reshape(out, dims)
+
+    def shuffle(self, x):
+        """Fisher-Yates shuffle of ``x`` in place along its first axis."""
+        randrange = self._rng.randrange
+        for i in range(len(x) - 1, 0, -1):
+            j = randrange(i + 1)
+            x[i], x[j] = x[j], x[i]
+
+    def permutation(self, x):
+        """Shuffled copy of ``x``, or of ``range(x)`` for an int."""
+        out = list(range(x)) if isinstance(x, Integral) else list(x)
+        self.shuffle(out)
+        return out
+
+
+def default_rng(seed=None):
+    """Construct a `Generator`, passing an existing one through unchanged."""
+    if isinstance(seed, Generator):
+        return seed
+    return Generator(seed)
@@ -0,0 +1,297 @@
+"""Structured (record) dtypes over packed binary buffers.
+
+A `StructDtype` describes a C-like record of named scalar fields, possibly
+nested, laid out either packed or with C alignment. A `RecordArray`
+interprets any bytes-like buffer as an array of such records without
+copying it. Indexing by field name returns a strided view onto the same
+buffer, and `RecordArray.to_columnar` decodes every field at once into
+per-field lists with a single `struct.iter_unpack` pass.
+"""
+
+import struct
+from numbers import Integral
+
+# Scalar type codes (NumPy spelling) to struct codes.
+_CODES = {
+    'b1': '?',
+    'i1': 'b', 'u1': 'B',
+    'i2': 'h', 'u2': 'H',
+    'i4': 'i', 'u4': 'I',
+    'i8': 'q', 'u8': 'Q',
+    'f2': 'e', 'f4': 'f', 'f8': 'd',
+}
+
+
+def _round_up(n, k):
+    return -(-n // k) * k
+
+
+class StructDtype:
+    """Record layout built from ``[(name, type), ...]``.
+
+    ``type`` is a scalar code such as ``'u4'`` or ``'f8'``, ``'S<n>'`` for
+    an ``n``-byte string, or a nested field list / `StructDtype`. With
+    ``align=True`` fields are placed at their natural alignment and the
+    record is padded like a C struct; otherwise fields are packed.
+    ``byteorder`` is ``'<'`` or ``'>'``.
+    """
+
+    def __init__(self, fields, align=False, byteorder='<'):
+        if byteorder not in '<>':
+            raise ValueError("byteorder must be '<' or '>'")
+        self.align = align
+        self.byteorder = byteorder
+        self.names = []
+        self.fields = {}
+        offset = 0
+        alignment = 1
+        for name, spec in fields:
+            if name in self.fields:
+                raise ValueError('duplicate field name %r' % name)
+            if isinstance(spec, StructDtype):
+                sub = spec
+            elif isinstance(spec, (list, tuple)):
+                sub = StructDtype(spec, align=align, byteorder=byteorder)
+            else:
+                sub = _Scalar(spec)
+            a = sub.alignment if align else 1
+            offset = _round_up(offset, a)
+            self.names.append(name)
+            self.fields[name] = (sub, offset)
+            offset += sub.itemsize
+            alignment = max(alignment, a)
+        self.alignment = alignment
+        self.itemsize = _round_up(offset, alignment) if align else offset
+        self._leaves = list(self._walk('', 0))
+        self._record = struct.Struct(self._format(self._leaves, 0, self.itemsize))
+
+    def _walk(self, prefix, base):
+        for name in self.names:
+            sub, off = self.fields[name]
+            if isinstance(sub, StructDtype):
+                yield from sub._walk(prefix + name + '.', base + off)
+            else:
+                yield prefix + name, sub.code, base + off, sub.itemsize
+
+    def _format(self, leaves, inner, stride):
+        # struct format reading ``leaves`` from one ``stride``-byte step whose
+        # record starts ``inner`` bytes in, with explicit padding elsewhere.
+        parts = [self.byteorder]
+        pos = 0
+        for _, code, off, size in leaves:
+            off += inner
+            if off > pos:
+                parts.append('%dx' % (off - pos))
+            parts.append(code)
+            pos = off + size
+        if stride > pos:
+            parts.append('%dx' % (stride - pos))
+        return ''.join(parts)
+
+    @property
+    def leaf_names(self):
+        """Dotted names of the scalar fields, in declaration order."""
+        return [leaf[0] for leaf in self._leaves]
+
+    def pack(self, record):
+        """Encode a (nested) tuple as ``itemsize`` bytes."""
+        return self._record.pack(*self._flatten(record))
+
+    def _flatten(self, record):
+        out = []
+        for name, value in zip(self.names, record):
+            sub = self.fields[name][0]
+            if isinstance(sub, StructDtype):
+                out.extend(sub._flatten(value))
+            else:
+                out.append(value)
+        return out
+
+    def _nest(self, flat, pos=0):
+        out = []
+        for name in self.names:
+            sub = self.fields[name][0]
+            if isinstance(sub, StructDtype):
+                value, pos = sub._nest(flat, pos)
+            else:
+                value, pos = flat[pos], pos + 1
+            out.append(value)
+        return tuple(out), pos
+
+    def __eq__(self, other):
+        return (isinstance(other, StructDtype)
+                and self._record.format == other._record.format
+                and self.names == other.names
+                and all(self.fields[n] == other.fields[n] for n in self.names))
+
+    def __hash__(self):
+        return hash((self._record.format, tuple(self.names)))
+
+    def __repr__(self):
+        return 'StructDtype(%r, itemsize=%d)' % (
+            [(n, self.fields[n][0]) for n in self.names], self.itemsize)
+
+
+class _Scalar:
+    __slots__ = ('name', 'code', 'itemsize', 'alignment')
+
+    def __init__(self, spec):
+        spec = str(spec)
+        if spec.startswith('S') and spec[1:].isdigit():
+            n = int(spec[1:])
+            self.code = '%ds' % n
+            self.itemsize = n
+            self.alignment = 1
+        elif spec in _CODES:
+            self.code = _CODES[spec]
+            self.itemsize = struct.calcsize('<' + self.code)
+            self.alignment = self.itemsize
+        else:
+            raise TypeError('unsupported field type %r' % spec)
+        self.name = spec
+
+    def __eq__(self, other):
+        return isinstance(other, _Scalar) and self.name == other.name
+
+    def __hash__(self):
+        return hash(self.name)
+
+    def __repr__(self):
+        return repr(self.name)
+
+
+class _Strided:
+    # Shared addressing: element i lives at start + i*stride + inner.
+
+    def __init__(self, buf, count, start, stride, inner):
+        self._buf = buf
+        self._count = count
+        self._start = start
+        self._stride = stride
+        self._inner = inner
+
+    def __len__(self):
+        return self._count
+
+    def _index(self, i):
+        if not isinstance(i, Integral):
+            raise TypeError('indices must be integers or field names')
+        if i < 0:
+            i += self._count
+        if not 0 <= i < self._count:
+            raise IndexError('index out of range')
+        return self._start + i * self._stride + self._inner
+
+    def _region(self):
+        return self._buf[self._start:self._start + self._count * self._stride]
+
+
+class FieldView(_Strided):
+    """Strided, zero-copy view of one scalar field across all records."""
+
+    def __init__(self, buf, count, start, stride, inner, code, byteorder):
+        super().__init__(buf, count, start, stride, inner)
+        self._struct = struct.Struct(byteorder + code)
+        self._bulk = struct.Struct('%s%s%s%s' % (
+            byteorder, '%dx' % inner if inner else '', code,
+            '%dx' % (stride - inner - self._struct.size)
+            if stride > inner + self._struct.size else ''))
+
+    def __getitem__(self, i):
+        return self._struct.unpack_from(self._buf, self._index(i))[0]
+
+    def __setitem__(self, i, value):
+        self._struct.pack_into(self._buf, self._index(i), value)
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def tolist(self):
+        """Decode the whole field in one C-level pass over the buffer."""
+        return [t[0] for t in self._bulk.iter_unpack(self._region())]
+
+    def __repr__(self):
+        return 'FieldView(%r)' % (self.tolist(),)
+
+
+class RecordArray(_Strided):
+    """Array of ``dtype`` records over a bytes-like ``buffer``, without copying.
+
+    ``arr['name']`` returns a `FieldView` (or a nested `RecordArray` for
+    struct-typed fields) that shares the buffer; writes through a view
+    update the buffer when it is writable. ``arr[i]`` decodes one record
+    as a nested tuple.
+    """
+
+    def __init__(self, buffer, dtype, count=None, offset=0,
+                 _stride=None, _inner=0):
+        if not isinstance(dtype, StructDtype):
+            dtype = StructDtype(dtype)
+        buf = memoryview(buffer).cast('B')
+        stride = dtype.itemsize if _stride is None else _stride
+        if count is None:
+            count = (len(buf) - offset) // stride if stride else 0
+        if offset + count * stride > len(buf):
+            raise ValueError('buffer is too small for %d records' % count)
+        super().__init__(buf, count, offset, stride, _inner)
+        self.dtype = dtype
+        self._rows = struct.Struct(dtype._format(dtype._leaves, _inner, stride))
+
+    @classmethod
+    def from_records(cls, records, dtype):
+        """Pack an iterable of (nested) tuples into a new writable buffer."""
+        if not isinstance(dtype, StructDtype):
+            dtype = StructDtype(dtype)
+        buf = bytearray(b''.join(dtype.pack(r) for r in records))
+        return cls(buf, dtype)
+
+    @property
+    def buffer(self):
+        return self._buf
+
+    def __getitem__(self, key):
+        if isinstance(key, str):
+            return self.field(key)
+        flat = self._rows.unpack_from(self._buf, self._index(key) - self._inner)
+        return self.dtype._nest(flat)[0]
+
+    def __setitem__(self, key, record):
+        self._rows.pack_into(self._buf, self._index(key) - self._inner,
+                             *self.dtype._flatten(record))
+
+    def field(self, name):
+        """View of field ``name``; dotted names reach into nested records."""
+        head, _, rest = name.partition('.')
+        if head not in self.dtype.fields:
+            raise KeyError(head)
+        sub, off = self.dtype.fields[head]
+        inner = self._inner + off
+        if isinstance(sub, StructDtype):
+            view = RecordArray(self._buf, sub, self._count, self._start,
+                               _stride=self._stride, _inner=inner)
+            return view.field(rest) if rest else view
+        if rest:
+            raise KeyError(name)
+        return FieldView(self._buf, self._count, self._start, self._stride,
+                         inner, sub.code, self.dtype.byteorder)
+
+    def tolist(self):
+        nest = self.dtype._nest
+        return [nest(row)[0] for row in self._rows.iter_unpack(self._region())]
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def to_columnar(self):
+        """Transpose records into ``{dotted_field_name: list}`` columns.
+
+        One `struct.iter_unpack` pass decodes every record; ``zip`` then
+        regroups the values by field.
+        """
+        names = self.dtype.leaf_names
+        rows = self._rows.iter_unpack(self._region())
+        columns = [list(c) for c in zip(*rows)] or [[] for _ in names]
+        return dict(zip(names, columns))
+
+    def __repr__(self):
+        return 'RecordArray(%r, dtype=%r)' % (self.tolist(), self.dtype)
@@ -0,0 +1,395 @@
+"""Sparse matrices in COO, CSR and CSC form.
+
+Build a matrix as COO triplets, convert it to CSR (row-major) or CSC
+(column-major) for arithmetic, and multiply it with dense vectors and nested
+lists via ``@``. Compressed formats keep the index arrays they were given,
+so wrapping existing ``(data, indices, indptr)`` buffers does not copy them.
+
+Products take a ``workers`` count that splits their rows into nnz-balanced
+ranges run on a thread pool. Other modules follow the same convention. The
+threads only run in parallel on a free-threaded (no-GIL) interpreter; with
+the GIL they take turns, and ``workers`` only adds overhead.
+"""
+
+import bisect
+import operator
+from concurrent.futures import ThreadPoolExecutor
+from itertools import repeat
+
+from .core import shape as _dense_shape
+
+
+_first = operator.itemgetter(0)
+
+
+def _is_sparse(x):
+    return isinstance(x, _SparseMatrix)
+
+
+def _as_dense(x):
+    # Typed 1-D containers (ComplexArray, Float16Array, ...) expose tolist().
+    if not isinstance(x, (list, tuple)) and hasattr(x, 'tolist'):
+        return x.tolist()
+    return x
+
+
+def _coo_from_dense(dense):
+    data, row, col = [], [], []
+    for i, r in enumerate(dense):
+        for j, v in enumerate(r):
+            if v:
+                data.append(v)
+                row.append(i)
+                col.append(j)
+    dims = _dense_shape(dense)
+    if len(dims) == 1:
+        dims = (dims[0], 0)
+    return data, row, col, dims
+
+
+def _compress(n_major, major, minor, data):
+    """Counting-sort triplets into compressed form, summing duplicates."""
+    counts = [0] * (n_major + 1)
+    for m in major:
+        counts[m + 1] += 1
+    for i in range(n_major):
+        counts[i + 1] += counts[i]
+    nnz = len(data)
+    order = [0] * nnz
+    nxt = counts[:-1]
+    for k, m in enumerate(major):
+        order[nxt[m]] = k
+        nxt[m] += 1
+
+    indptr = [0] * (n_major + 1)
+    indices = []
+    values = []
+    for i in range(n_major):
+        # Key on the index alone: data values may not be orderable (complex).
+        seg = sorted(((minor[k], data[k]) for k in order[counts[i]:counts[i + 1]]),
+                     key=_first)
+        last = -1
+        for j, v in seg:
+            if j == last:
+                values[-1] += v
+            else:
+                indices.append(j)
+                values.append(v)
+                last = j
+        indptr[i + 1] = len(indices)
+    return values, indices, indptr
+
+
+def merge_path_partition(indptr, parts):
+    """Split rows into ``parts`` contiguous ranges of near-equal work.
+
+    Work for row ``r`` is one unit plus its nonzeros, so the cut points are
+    equal steps along the merge path of row ends and nonzeros. Returns the
+    row boundaries ``[0, r1, ..., n_rows]``.
+    """
+    n = len(indptr) - 1
+    parts = max(1, min(parts, n))
+    total = n + indptr[n]
+    path = _MergePath(indptr)
+    bounds = [0]
+    for p in range(1, parts):
+        r = bisect.bisect_left(path, total * p // parts, bounds[-1], n)
+        bounds.append(max(r, bounds[-1]))
+    bounds.append(n)
+    return bounds
+
+
+class _MergePath:
+    # Lazy view of ``indptr[r] + r`` so bisect can search it without a copy.
+    __slots__ = ('indptr',)
+
+    def __init__(self, indptr):
+        self.indptr = indptr
+
+    def __getitem__(self, r):
+        return self.indptr[r] + r
+
+    def __len__(self):
+        return len(self.indptr)
+
+
+def _run_partitioned(indptr, workers, kernel):
+    # kernel(lo, hi) returns the output rows lo..hi; results are concatenated.
+    if workers is None or workers <= 1 or len(indptr) <= 2:
+        return kernel(0, len(indptr) - 1)
+    bounds = merge_path_partition(indptr, workers)
+    ranges = list(zip(bounds[:-1], bounds[1:]))
+    with ThreadPoolExecutor(max_workers=len(ranges)) as pool:
+        chunks = list(pool.map(lambda r: kernel(*r), ranges))
+    return [y for chunk in chunks for y in chunk]
+
+
+class _SparseMatrix:
+    format = None
+
+    @property
+    def nnz(self):
+        return len(self.data)
+
+    @property
+    def T(self):
+        return self.transpose()
+
+    def toarray(self):
+        """Dense nested-list copy of the matrix."""
+        m, n = self.shape
+        out = [[0] * n for _ in range(m)]
+        c = self.tocoo()
+        for v, i, j in zip(c.data, c.row, c.col):
+            out[i][j] += v
+        return out
+
+    def __matmul__(self, other):
+        return self.dot(other)
+
+    def __rmatmul__(self, other):
+        # dense @ sparse == (sparse.T @ dense.T).T
+        other = _as_dense(other)
+        dims = _dense_shape(other)
+        t = self.transpose().tocsr()
+        if len(dims) == 1:
+            return t.dot(other)
+        cols = [list(c) for c in zip(*other)]
+        return [list(r) for r in zip(*t.dot(cols))]
+
+    def __repr__(self):
+        return '<%dx%d sparse matrix with %d stored elements in %s format>' % (
+            self.shape[0], self.shape[1], self.nnz, self.format.upper())
+
+
+class coo_matrix(_SparseMatrix):
+    """Coordinate-format matrix: parallel ``data``, ``row``, ``col`` lists.
+
+    ``coo_matrix((data, (row, col)), shape=(m, n))`` or
+    ``coo_matrix(dense_nested_list)``. Duplicate entries are allowed and are
+    summed on conversion.
+    """
+
+    format = 'coo'
+
+    def __init__(self, arg, shape=None):
+        if _is_sparse(arg):
+            c = arg.tocoo()
+            data, row, col, dims = c.data, c.row, c.col, c.shape
+        elif isinstance(arg, tuple) and len(arg) == 2 and isinstance(arg[1], tuple):
+            data, (row, col) = arg
+            dims = shape
+            if dims is None:
+                dims = (max(row, default=-1) + 1, max(col, default=-1) + 1)
+        else:
+            data, row, col, dims = _coo_from_dense(arg)
+        if not len(data) == len(row) == len(col):
+            raise ValueError('data, row and col must have the same length')
+        m, n = dims = (int(dims[0]), int(dims[1]))
+        if any(not 0 <= i < m for i in row) or any(not 0 <= j < n for j in col):
+            raise ValueError('index out of bounds for shape %r' % (dims,))
+        self.data, self.row, self.col = data, row, col
+        self.shape = dims
+
+    def tocoo(self):
+        return self
+
+    def tocsr(self):
+        values, indices, indptr = _compress(self.shape[0], self.row, self.col,
+                                            self.data)
+        return csr_matrix((values, indices, indptr), shape=self.shape)
+
+    def tocsc(self):
+        values, indices, indptr = _compress(self.shape[1], self.col, self.row,
+                                            self.data)
+        return csc_matrix((values, indices, indptr), shape=self.shape)
+
+    def transpose(self):
+        return coo_matrix((self.data, (self.col, self.row)),
+                          shape=(self.shape[1], self.shape[0]))
+
+    def dot(self, other, workers=None):
+        return self.tocsr().dot(other, workers=workers)
+
+
+class _Compressed(_SparseMatrix):
+    # Shared storage for CSR/CSC; "major" is rows for CSR, columns for CSC.
+
+    def __init__(self, arg, shape=None):
+        if isinstance(arg, tuple) and len(arg) == 3:
+            data, indices, indptr = arg
+            if shape is None:
+                n_major = len(indptr) - 1
+                n_minor = max(indices, default=-1) + 1
+                shape = self._swap((n_major, n_minor))
+            if len(data) != len(indices):
+                raise ValueError('data and indices must have the same length')
+            if len(indptr) != self._swap(shape)[0] + 1:
+                raise ValueError('indptr length does not match shape')
+        else:
+            c = coo_matrix(arg, shape=shape)
+            other = c.tocsr() if self.format == 'csr' else c.tocsc()
+            data, indices, indptr, shape = (other.data, other.indices,
+                                            other.indptr, other.shape)
+        self.data, self.indices, self.indptr = data, indices, indptr
+        self.shape = (int(shape[0]), int(shape[1]))
+
+    def _swap(self, dims):
+        return dims if self.format == 'csr' else (dims[1], dims[0])
+
+    def _major_coords(self):
+        indptr = self.indptr
+        out = []
+        for i in range(len(indptr) - 1):
+            out.extend([i] * (indptr[i + 1] - indptr[i]))
+        return out
+
+    def tocoo(self):
+        major = self._major_coords()
+        minor = list(self.indices)
+        if self.format == 'csr':
+            return coo_matrix((list(self.data), (major, minor)), shape=self.shape)
+        return coo_matrix((list(self.data), (minor, major)), shape=self.shape)
+
+    def diagonal(self):
+        """Main diagonal as a list."""
+        m, n = self.shape
+        out = [0] * min(m, n)
+        data, indices, indptr = self.data, self.indices, self.indptr
+        for i in range(len(out)):
+            for k in range(indptr[i], indptr[i + 1]):
+                if indices[k] == i:
+                    out[i] += data[k]
+        return out
+
+
+class csr_matrix(_Compressed):
+    """Compressed sparse row matrix.
+
+    ``csr_matrix((data, indices, indptr), shape=(m, n))`` wraps existing
+    buffers without copying; ``csr_matrix(coo_or_dense)`` converts.
+    Products accept ``workers`` to split rows into nnz-balanced ranges (see
+    `merge_path_partition`) that run on a thread pool.
+    """
+
+    format = 'csr'
+
+    def tocsr(self):
+        return self
+
+    def tocsc(self):
+        return self.tocoo().tocsc()
+
+    def transpose(self):
+        return csc_matrix((self.data, self.indices, self.indptr),
+                          shape=(self.shape[1], self.shape[0]))
+
+    def _matvec(self, x, workers):
+        data, indices, indptr = self.data, self.indices, self.indptr
+        mul = operator.mul
+        get = x.__getitem__
+
+        def kernel(lo, hi):
+            return [sum(map(mul, data[indptr[i]:indptr[i + 1]],
+                            map(get, indices[indptr[i]:indptr[i + 1]])))
+                    for i in range(lo, hi)]
+
+        return _run_partitioned(indptr, workers, kernel)
+
+    def _matmat(self, B, workers):
+        data, indices, indptr = self.data, self.indices, self.indptr
+        n = len(B[0]) if B else 0
+        add, mul = operator.add, operator.mul
+
+        def kernel(lo, hi):
+            rows = []
+            for i in range(lo, hi):
+                acc = [0] * n
+                for k in range(indptr[i], indptr[i + 1]):
+                    acc = list(map(add, acc, map(mul, repeat(data[k]), B[indices[k]])))
+                rows.append(acc)
+            return rows
+
+        return _run_partitioned(indptr, workers, kernel)
+
+    def _matsparse(self, other):
+        # Gustavson's row-by-row SpGEMM with a dense accumulator per row.
+        b = other.tocsr()
+        n = b.shape[1]
+        acc = [0] * n
+        mark = [-1] * n
+        data, indices, indptr = [], [], [0]
+        for i in range(self.shape[0]):
+            cols = []
+            for k in range(self.indptr[i], self.indptr[i + 1]):
+                a = self.data[k]
+                r = self.indices[k]
+                for kb in range(b.indptr[r], b.indptr[r + 1]):
+                    j = b.indices[kb]
+                    if mark[j] != i:
+                        mark[j] = i
+                        acc[j] = 0
+                        cols.append(j)
+                    acc[j] += a * b.data[kb]
+            cols.sort()
+            indices.extend(cols)
+            data.extend(acc[j] for j in cols)
+            indptr.append(len(indices))
+        return csr_matrix((data, indices, indptr), shape=(self.shape[0], n))
+
+    def dot(self, other, workers=None):
+        """Multiply by a dense vector, a nested-list matrix or a sparse matrix."""
+        if _is_sparse(other):
+            if other.shape[0] != self.shape[1]:
+                raise ValueError('dimension mismatch')
+            return self._matsparse(other)
+        other = _as_dense(other)
+        dims = _dense_shape(other)
+        if not dims or dims[0] != self.shape[1]:
+            raise ValueError('dimension mismatch')
+        if len(dims) == 1:
+            return self._matvec(other, workers)
+        if len(dims) == 2:
+            return self._matmat(other, workers)
+        raise ValueError('dense operand must be 1-D or 2-D')
+
+
+class csc_matrix(_Compressed):
+    """Compressed sparse column matrix; the transpose view of `csr_matrix`."""
+
+    format = 'csc'
+
+    def tocsc(self):
+        return self
+
+    def tocsr(self):
+        return self.tocoo().tocsr()
+
+    def transpose(self):
+        return csr_matrix((self.data, self.indices, self.indptr),
+                          shape=(self.shape[1], self.shape[0]))
+
+    def dot(self, other, workers=None):
+        if _is_sparse(other):
+            return self.tocsr().dot(other)
+        other = _as_dense(other)
+        dims = _dense_shape(other)
+        if not dims or dims[0] != self.shape[1]:
+            raise ValueError('dimension mismatch')
+        if len(dims) == 1:
+            # Column-wise scatter avoids converting to CSR for a single SpMV.
+            y = [0] * self.shape[0]
+            data, indices, indptr = self.data, self.indices, self.indptr
+            for j in range(self.shape[1]):
+                xj = other[j]
+                if xj:
+                    for k in range(indptr[j], indptr[j + 1]):
+                        y[indices[k]] += data[k] * xj
+            return y
+        return self.tocsr().dot(other, workers=workers)
+
+
+def eye(n, format='csr'):
+    """Sparse ``n`` x ``n`` identity."""
+    m = csr_matrix(([1.0] * n, list(range(n)), list(range(n + 1))), shape=(n, n))
+    return m if format == 'csr' else m.tocoo() if format == 'coo' else m.tocsc()
@@ -0,0 +1,408 @@
+"""Solvers for sparse linear systems.
+
+Iterative Krylov solvers (`cg`, `bicgstab`, `gmres`) only need ``A.dot(x)``
+and work directly on the caller's `csr_matrix` without copying it. They
+return ``(x, info)`` where ``info`` is 0 on convergence, the iteration
+count if it ran out of iterations, and the negated count on breakdown.
+Preconditioners are callables mapping a residual to an approximate
+solution; `jacobi` and `ilu0` build them from a CSR matrix.
+
+`cholesky` factors a symmetric positive definite matrix after a fill-
+reducing minimum degree ordering and returns a reusable `CholeskyFactor`.
+"""
+
+import heapq
+import math
+
+from .sparse import csc_matrix
+
+
+def _dot(x, y):
+    return math.fsum(a * b for a, b in zip(x, y))
+
+
+def _norm(x):
+    return math.sqrt(_dot(x, x))
+
+
+def _identity(r):
+    return list(r)
+
+
+def _prepare(A, b, x0, M):
+    n = A.shape[0]
+    if A.shape[1] != n or len(b) != n:
+        raise ValueError('A must be square and match b')
+    x = [0.0] * n if x0 is None else [float(v) for v in x0]
+    return n, x, (M or _identity)
+
+
+# -- preconditioners ---------------------------------------------------------
+
+class jacobi:
+    """Diagonal (Jacobi) preconditioner ``z = r / diag(A)``."""
+
+    def __init__(self, A):
+        d = A.diagonal()
+        if any(v == 0 for v in d):
+            raise ValueError('matrix has a zero on the diagonal')
+        self.inv_diag = [1.0 / v for v in d]
+
+    def __call__(self, r):
+        return [a * b for a, b in zip(self.inv_diag, r)]
+
+
+class ilu0:
+    """Incomplete LU factorisation with the sparsity pattern of ``A``.
+
+    ``L`` (unit lower) and ``U`` share one CSR copy of the values; the
+    pattern arrays of ``A`` are reused when its rows are already sorted.
+    """
+
+    def __init__(self, A):
+        A = A.tocsr()
+        n = A.shape[0]
+        indptr, indices = A.indptr, A.indices
+        if any(indices[k] >= indices[k + 1]
+               for i in range(n) for k in range(indptr[i], indptr[i + 1] - 1)):
+            A = A.tocoo().tocsr()
+            indptr, indices = A.indptr, A.indices
+        a = [float(v) for v in A.data]
+        diag = [-1] * n
+        pos = [-1] * n
+        for i in range(n):
+            lo, hi = indptr[i], indptr[i + 1]
+            for q in range(lo, hi):
+                pos[indices[q]] = q
+            for p in range(lo, hi):
+                k = indices[p]
+                if k >= i:
+                    break
+                lik = a[p] / a[diag[k]]
+                a[p] = lik
+                for q in range(diag[k] + 1, indptr[k + 1]):
+                    t = pos[indices[q]]
+                    if t != -1:
+                        a[t] -= lik * a[q]
+            for q in range(lo, hi):
+                pos[indices[q]] = -1
+                if indices[q] == i:
+                    diag[i] = q
+            if diag[i] == -1 or a[diag[i]] == 0.0:
+                raise ValueError('zero pivot in row %d' % i)
+        self.data, self.indices, self.indptr, self.diag = a, indices, indptr, diag
+
+    def __call__(self, r):
+        a, indices, indptr, diag = self.data, self.indices, self.indptr, self.diag
+        n = len(diag)
+        y = [float(v) for v in r]
+        for i in range(n):
+            s = y[i]
+            for p in range(indptr[i], diag[i]):
+                s -= a[p] * y[indices[p]]
+            y[i] = s
+        for i in range(n - 1, -1, -1):
+            s = y[i]
+            for p in range(diag[i] + 1, indptr[i + 1]):
+                s -= a[p] * y[indices[p]]
+            y[i] = s / a[diag[i]]
+        return y
+
+
+# -- Krylov solvers ----------------------------------------------------------
+
+def cg(A, b, x0=None, rtol=1e-5, atol=0.0, maxiter=None, M=None):
+    """Preconditioned conjugate gradient for symmetric positive definite A."""
+    n, x, M = _prepare(A, b, x0, M)
+    maxiter = 10 * n if maxiter is None else maxiter
+    stop = max(rtol * _norm(b), atol)
+    r = [bi - ai for bi, ai in zip(b, A.dot(x))]
+    if _norm(r) <= stop:
+        return x, 0
+    z = M(r)
+    p = list(z)
+    rz = _dot(r, z)
+    for it in range(1, maxiter + 1):
+        Ap = A.dot(p)
+        pAp = _dot(p, Ap)
+        if pAp == 0.0 or rz == 0.0:
+            return x, -it
+        alpha = rz / pAp
+        x = [xi + alpha * pi for xi, pi in zip(x, p)]
+        r = [ri - alpha * qi for ri, qi in zip(r, Ap)]
+        if _norm(r) <= stop:
+            return x, 0
+        z = M(r)
+        rz_new = _dot(r, z)
+        beta = rz_new / rz
+        rz = rz_new
+        p = [zi + beta * pi for zi, pi in zip(z, p)]
+    return x, maxiter
+
+
+def bicgstab(A, b, x0=None, rtol=1e-5, atol=0.0, maxiter=None, M=None):
+    """Right-preconditioned BiCGSTAB for general square A."""
+    n, x, M = _prepare(A, b, x0, M)
+    maxiter = 10 * n if maxiter is None else maxiter
+    stop = max(rtol * _norm(b), atol)
+    r = [bi - ai for bi, ai in zip(b, A.dot(x))]
+    if _norm(r) <= stop:
+        return x, 0
+    rhat = list(r)
+    rho = alpha = omega = 1.0
+    v = [0.0] * n
+    p = [0.0] * n
+    for it in range(1, maxiter + 1):
+        rho_new = _dot(rhat, r)
+        if rho_new == 0.0:
+            return x, -it
+        beta = (rho_new / rho) * (alpha / omega)
+        rho = rho_new
+        p = [ri + beta * (pi - omega * vi) for ri, pi, vi in zip(r, p, v)]
+        phat = M(p)
+        v = A.dot(phat)
+        rv = _dot(rhat, v)
+        if rv == 0.0:
+            return x, -it
+        alpha = rho / rv
+        s = [ri - alpha * vi for ri, vi in zip(r, v)]
+        if _norm(s) <= stop:
+            return [xi + alpha * pi for xi, pi in zip(x, phat)], 0
+        shat = M(s)
+        t = A.dot(shat)
+        tt = _dot(t, t)
+        omega = _dot(t, s) / tt if tt else 0.0
+        x = [xi + alpha * pi + omega * si for xi, pi, si in zip(x, phat, shat)]
+        r = [si - omega * ti for si, ti in zip(s, t)]
+        if _norm(r) <= stop:
+            return x, 0
+        if omega == 0.0:
+            return x, -it
+    return x, maxiter
+
+
+def gmres(A, b, x0=None, rtol=1e-5, atol=0.0, restart=20, maxiter=None, M=None):
+    """Restarted GMRES(m) with right preconditioning and Givens rotations.
+
+    ``maxiter`` counts restart cycles.
+    """
+    n, x, M = _prepare(A, b, x0, M)
+    maxiter = n if maxiter is None else maxiter
+    m = max(1, min(restart, n))
+    stop = max(rtol * _norm(b), atol)
+    for it in range(1, maxiter + 1):
+        r = [bi - ai for bi, ai in zip(b, A.dot(x))]
+        beta = _norm(r)
+        if beta <= stop:
+            return x, 0
+        V = [[ri / beta for ri in r]]
+        Z = []
+        H = []
+        cs, sn = [], []
+        g = [beta]
+        for j in range(m):
+            z = M(V[j])
+            Z.append(z)
+            w = A.dot(z)
+            h = []
+            for vi in V:
+                hij = _dot(w, vi)
+                w = [wk - hij * vk for wk, vk in zip(w, vi)]
+                h.append(hij)
+            hnext = _norm(w)
+            for i in range(j):
+                h[i], h[i + 1] = (cs[i] * h[i] + sn[i] * h[i + 1],
+                                  -sn[i] * h[i] + cs[i] * h[i + 1])
+            denom = math.hypot(h[j], hnext)
+            c, s = (1.0, 0.0) if denom == 0.0 else (h[j] / denom, hnext / denom)
+            cs.append(c)
+            sn.append(s)
+            h[j] = denom
+            g.append(-s * g[j])
+            g[j] *= c
+            H.append(h)
+            if abs(g[j + 1]) <= stop or hnext == 0.0:
+                break
+            V.append([wk / hnext for wk in w])
+        k = len(H)
+        if any(H[i][i] == 0.0 for i in range(k)):
+            # The Krylov space stopped growing before reaching b: A is
+            # singular on it.
+            return x, -it
+        y = [0.0] * k
+        for i in range(k - 1, -1, -1):
+            y[i] = (g[i] - sum(H[l][i] * y[l] for l in range(i + 1, k))) / H[i][i]
+        for i in range(k):
+            yi = y[i]
+            x = [xj + yi * zj for xj, zj in zip(x, Z[i])]
+        if abs(g[k]) <= stop:
+            return x, 0
+    return x, maxiter
+
+
+# -- sparse Cholesky ---------------------------------------------------------
+
+def minimum_degree(A):
+    """Fill-reducing permutation by minimum degree on the elimination graph.
+
+    Returns ``perm`` such that row/column ``perm[k]`` of A is eliminated
+    k-th. Degrees are exact (not AMD's approximate bounds), updated lazily
+    through a heap.
+    """
+    A = A.tocsr()
+    n = A.shape[0]
+    adj = [set() for _ in range(n)]
+    for i in range(n):
+        for p in range(A.indptr[i], A.indptr[i + 1]):
+            j = A.indices[p]
+            if j != i:
+                adj[i].add(j)
+                adj[j].add(i)
+    heap = [(len(adj[i]), i) for i in range(n)]
+    heapq.heapify(heap)
+    done = [False] * n
+    perm = []
+    while heap:
+        deg, v = heapq.heappop(heap)
+        if done[v] or deg != len(adj[v]):
+            continue
+        done[v] = True
+        perm.append(v)
+        nbrs = adj[v]
+        for u in nbrs:
+            au = adj[u]
+            au.discard(v)
+            au.update(nbrs)
+            au.discard(u)
+            heapq.heappush(heap, (len(au), u))
+        adj[v] = None
+    return perm
+
+
+class CholeskyFactor:
+    """``P A P^T = L L^T`` with ``L`` stored as a `csc_matrix`."""
+
+    def __init__(self, L, perm):
+        self.L = L
+        self.perm = perm
+
+    def solve(self, b):
+        L, perm = self.L, self.perm
+        data, indices, indptr = L.data, L.indices, L.indptr
+        n = len(perm)
+        y = [float(b[perm[k]]) for k in range(n)]
+        for j in range(n):
+            p0 = indptr[j]
+            yj = y[j] / data[p0]
+            y[j] = yj
+            for p in range(p0 + 1, indptr[j + 1]):
+                y[indices[p]] -= data[p] * yj
+        for j in range(n - 1, -1, -1):
+            p0 = indptr[j]
+            s = y[j]
+            for p in range(p0 + 1, indptr[j + 1]):
+                s -= data[p] * y[indices[p]]
+            y[j] = s / data[p0]
+        x = [0.0] * n
+        for k in range(n):
+            x[perm[k]] = y[k]
+        return x
+
+
+def cholesky(A, ordering='mindegree'):
+    """Up-looking sparse Cholesky of a symmetric positive definite matrix.
+
+    ``A`` must hold both triangles. ``ordering`` is ``'mindegree'`` or
+    ``'natural'``. The symbolic phase computes the elimination tree and the
+    row patterns of L, so the numeric phase allocates L exactly once.
+    """
+    A = A.tocsr()
+    n = A.shape[0]
+    if A.shape[1] != n:
+        raise ValueError('matrix must be square')
+    if ordering == 'mindegree':
+        perm = minimum_degree(A)
+    elif ordering == 'natural':
+        perm = list(range(n))
+    else:
+        raise ValueError('unknown ordering %r' % (ordering,))
+    pinv = [0] * n
+    for k, old in enumerate(perm):
+        pinv[old] = k
+    Ap, Ai, Ax = A.indptr, A.indices, A.data
+
+    def upper_col(k):
+        # Entries (i, v) of column k of P A P^T with i <= k.
+        old = perm[k]
+        for p in range(Ap[old], Ap[old + 1]):
+            i = pinv[Ai[p]]
+            if i <= k:
+                yield i, Ax[p]
+
+    parent = [-1] * n
+    ancestor = [-1] * n
+    for k in range(n):
+        for i, _ in upper_col(k):
+            while i != -1 and i < k:
+                nxt = ancestor[i]
+                ancestor[i] = k
+                if nxt == -1:
+                    parent[i] = k
+                i = nxt
+
+    mark = [-1] * n
+
+    def ereach(k):
+        # Pattern of row k of L in topological order (descendants first).
+        mark[k] = k
+        paths = []
+        for i, _ in upper_col(k):
+            path = []
+            while i != -1 and mark[i] != k:
+                path.append(i)
+                mark[i] = k
+                i = parent[i]
+            if path:
+                paths.append(path)
+        return [i for path in reversed(paths) for i in path]
+
+    patterns = [ereach(k) for k in range(n)]
+    counts = [1] * n
+    for pattern in patterns:
+        for i in pattern:
+            counts[i] += 1
+    Lp = [0] * (n + 1)
+    for j in range(n):
+        Lp[j + 1] = Lp[j] + counts[j]
+    Li = [0] * Lp[n]
+    Lx = [0.0] * Lp[n]
+    nxt = Lp[:-1]
+    x = [0.0] * n
+    for k in range(n):
+        for i, v in upper_col(k):
+            x[i] += v
+        d = x[k]
+        x[k] = 0.0
+        for i in patterns[k]:
+            lki = x[i] / Lx[Lp[i]]
+            x[i] = 0.0
+            for p in range(Lp[i] + 1, nxt[i]):
+                x[Li[p]] -= Lx[p] * lki
+            d -= lki * lki
+            p = nxt[i]
+            nxt[i] += 1
+            Li[p] = k
+            Lx[p] = lki
+        if d <= 0.0:
+            raise ValueError('matrix is not positive definite')
+        p = nxt[k]
+        nxt[k] += 1
+        Li[p] = k
+        Lx[p] = math.sqrt(d)
+    return CholeskyFactor(csc_matrix((Lx, Li, Lp), shape=(n, n)), perm)
+
+
+def spsolve(A, b):
+    """Solve ``A x = b`` for symmetric positive definite sparse A."""
+    return cholesky(A).solve(b)
+
@@ -0,0 +1,425 @@
+"""Pairwise distances and nearest-neighbour search over row vectors.
+
+`cdist` computes the distance from every row of ``XA`` to every row of
+``XB``; `pdist` computes the condensed upper triangle of all pairs within
+one set, and `squareform` converts between that and a full matrix.
+
+Euclidean distance is `math.dist`, one C call per pair, and squared
+euclidean is its square; both agree bit for bit with the distances the
+neighbour searches below use. Cosine distance computes row norms once, so
+each pair costs a single dot product, ``sum(map(mul, x, y))``. The other
+metrics fold one ``map`` over each pair.
+
+Nearest neighbours never need the full distance matrix:
+
+* `knn` is exact brute force. Each query computes one row of distances and
+  immediately keeps its ``k`` smallest with `heapq.nsmallest`, so memory
+  stays O(n) per query.
+* `KDTree` is exact and sublinear in low dimensions. It splits on the
+  widest coordinate at the median down to small leaves, and a query keeps
+  a bounded max-heap of the best ``k`` while pruning subtrees whose
+  splitting plane is farther than the current ``k``-th distance.
+* `IVFFlat` is approximate. k-means centroids partition the data into
+  inverted lists, and a query scans only the ``nprobe`` lists whose
+  centroids are nearest.
+
+``workers`` splits output rows or queries into blocks run on a thread pool,
+as described in `sparse`.
+"""
+
+import bisect
+import heapq
+import math
+import operator
+import random
+from concurrent.futures import ThreadPoolExecutor
+from itertools import repeat
+
+from .core import shape as _shape
+
+_METRICS = ('euclidean', 'sqeuclidean', 'cosine', 'cityblock', 'manhattan',
+            'chebyshev', 'hamming', 'jaccard')
+
+
+def _rows(X, name):
+    if not isinstance(X, (list, tuple)) and hasattr(X, 'tolist'):
+        X = X.tolist()
+    dims = _shape(X)
+    if len(dims) != 2 and dims != (0,):
+        raise ValueError('%s must be a 2-D array' % name)
+    return [list(r) for r in X]
+
+
+def _sqnorms(X):
+    return [sum(map(operator.mul, x, x)) for x in X]
+
+
+def _row_kernel(metric, XA, XB):
+    """``row(i, start)``: distances from ``XA[i]`` to ``XB[start:]``."""
+    sub = operator.sub
+    if callable(metric):
+        return lambda i, start=0: [metric(XA[i], y) for y in XB[start:]]
+    if metric == 'euclidean':
+        return lambda i, start=0: list(map(math.dist, repeat(XA[i]),
+                                           XB[start:]))
+    if metric == 'sqeuclidean':
+        return lambda i, start=0: [d * d for d in map(math.dist, repeat(XA[i]),
+                                                      XB[start:])]
+    if metric == 'cosine':
+        na = list(map(math.sqrt, _sqnorms(XA)))
+        nb = na if XB is XA else list(map(math.sqrt, _sqnorms(XB)))
+        mul = operator.mul
+
+        def cosine(i, start=0):
+            x, nx = XA[i], na[i]
+            return [1.0 - sum(map(mul, x, y)) / (nx * ny) if nx and ny
+                    else math.nan for y, ny in zip(XB[start:], nb[start:])]
+        return cosine
+    if metric in ('cityblock', 'manhattan'):
+        return lambda i, start=0: [sum(map(abs, map(sub, XA[i], y)))
+                                   for y in XB[start:]]
+    if metric == 'chebyshev':
+        return lambda i, start=0: [max(map(abs, map(sub, XA[i], y)), default=0)
+                                   for y in XB[start:]]
+    if metric == 'hamming':
+        ne = operator.ne
+
+        def hamming(i, start=0):
+            x = XA[i]
+            n = len(x)
+            return [sum(map(ne, x, y)) / n if n else math.nan
+                    for y in XB[start:]]
+        return hamming
+    if metric == 'jaccard':
+        # Boolean Jaccard: differing nonzeros over nonzeros in either row.
+        ba = [list(map(bool, x)) for x in XA]
+        bb = ba if XB is XA else [list(map(bool, y)) for y in XB]
+        or_, xor = operator.or_, operator.xor
+
+        def jaccard(i, start=0):
+            x = ba[i]
+            out = []
+            for y in bb[start:]:
+                union = sum(map(or_, x, y))
+                out.append(sum(map(xor, x, y)) / union if union else 0.0)
+            return out
+        return jaccard
+    raise ValueError('unknown metric %r; expected one of %s or a callable'
+                     % (metric, ', '.join(_METRICS)))
+
+
+def _run_blocks(n_rows, workers, kernel):
+    # kernel(lo, hi) returns output rows lo..hi; blocks are concatenated.
+    if workers is None or workers <= 1 or n_rows <= 1:
+        return kernel(0, n_rows)
+    workers = min(workers, n_rows)
+    bounds = [n_rows * p // workers for p in range(workers + 1)]
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        chunks = list(pool.map(kernel, bounds[:-1], bounds[1:]))
+    return [row for chunk in chunks for row in chunk]
+
+
+def cdist(XA, XB, metric='euclidean', workers=None):
+    """Distance matrix between the rows of ``XA`` (m x d) and ``XB`` (n x d).
+
+    ``metric`` is one of ``'euclidean'``, ``'sqeuclidean'``, ``'cosine'``,
+    ``'cityblock'`` (alias ``'manhattan'``), ``'chebyshev'``, ``'hamming'``,
+    ``'jaccard'`` or a callable ``metric(u, v)``. Returns an m x n nested list.
+    """
+    XA = _rows(XA, 'XA')
+    XB = _rows(XB, 'XB')
+    if XA and XB and len(XA[0]) != len(XB[0]):
+        raise ValueError('XA and XB must have the same number of columns')
+    row = _row_kernel(metric, XA, XB)
+    return _run_blocks(len(XA), workers,
+                       lambda lo, hi: [row(i) for i in range(lo, hi)])
+
+
+def pdist(X, metric='euclidean', workers=None):
+    """Condensed distances ``d(X[i], X[j])`` for ``i < j``, row by row.
+
+    Entry ``(i, j)`` sits at ``n*i - i*(i+1)//2 + j - i - 1``, as in SciPy.
+    """
+    X = _rows(X, 'X')
+    row = _row_kernel(metric, X, X)
+    rows = _run_blocks(len(X), workers,
+                       lambda lo, hi: [row(i, i + 1) for i in range(lo, hi)])
+    return [d for r in rows for d in r]
+
+
+def squareform(d):
+    """Convert a condensed distance list to a square matrix, or back."""
+    if d and isinstance(d[0], (list, tuple)):
+        n = len(d)
+        return [d[i][j] for i in range(n) for j in range(i + 1, n)]
+    n = int(round((1 + math.sqrt(1 + 8 * len(d))) / 2)) if d else 1
+    if n * (n - 1) // 2 != len(d):
+        raise ValueError('condensed distance length %d is not n*(n-1)/2'
+                         % len(d))
+    out = [[0.0] * n for _ in range(n)]
+    k = 0
+    for i in range(n):
+        for j in range(i + 1, n):
+            out[i][j] = out[j][i] = d[k]
+            k += 1
+    return out
+
+
+def _minkowski(p):
+    # Distance function for p = 1, 2 or inf, all C-level per pair.
+    sub = operator.sub
+    if p == 2:
+        return math.dist
+    if p == 1:
+        return lambda x, y: sum(map(abs, map(sub, x, y)))
+    if p == math.inf:
+        return lambda x, y: max(map(abs, map(sub, x, y)), default=0)
+    raise ValueError('p must be 1, 2 or inf')
+
+
+def _queries(x):
+    # (list of query rows, whether a single 1-D query was given)
+    if not isinstance(x, (list, tuple)) and hasattr(x, 'tolist'):
+        x = x.tolist()
+    dims = _shape(x)
+    if len(dims) == 1:
+        return [list(x)], True
+    if len(dims) != 2:
+        raise ValueError('queries must be a 1-D point or a 2-D array')
+    return [list(r) for r in x], False
+
+
+def _knn_result(results, k, single):
+    # results: per query, a list of (distance, index) in ascending order.
+    # Shapes follow SciPy: k == 1 drops the neighbour axis.
+    if k == 1:
+        dist = [r[0][0] if r else math.inf for r in results]
+        idx = [r[0][1] if r else -1 for r in results]
+    else:
+        dist = [[d for d, _ in r] + [math.inf] * (k - len(r)) for r in results]
+        idx = [[i for _, i in r] + [-1] * (k - len(r)) for r in results]
+    if single:
+        return dist[0], idx[0]
+    return dist, idx
+
+
+def knn(data, x, k=1, metric='euclidean', workers=None):
+    """Exact ``k`` nearest rows of ``data`` to each query, by brute force.
+
+    ``metric`` is any `cdist` metric. Returns ``(distances, indices)``
+    shaped like `KDTree.query`. Only one row of distances per query is
+    alive at a time.
+    """
+    data = _rows(data, 'data')
+    queries, single = _queries(x)
+    row = _row_kernel(metric, queries, data)
+    n = len(data)
+
+    def kernel(lo, hi):
+        out = []
+        for q in range(lo, hi):
+            d = row(q)
+            best = heapq.nsmallest(k, range(n), key=d.__getitem__)
+            out.append([(d[i], i) for i in best])
+        return out
+
+    return _knn_result(_run_blocks(len(queries), workers, kernel), k, single)
+
+
+class KDTree:
+    """k-d tree over the rows of ``data`` for exact nearest-neighbour queries.
+
+    Nodes live in parallel lists: an inner node splits on ``dim`` at
+    ``value`` (points with ``coord <= value`` go left), and a leaf owns the
+    range ``start:end`` of the permuted index list.
+    """
+
+    def __init__(self, data, leafsize=16):
+        self.data = _rows(data, 'data')
+        self.n = len(self.data)
+        self.m = len(self.data[0]) if self.data else 0
+        self.leafsize = max(1, leafsize)
+        self.indices = list(range(self.n))
+        self._dim, self._value = [], []
+        self._left, self._right = [], []
+        self._start, self._end = [], []
+        if self.n:
+            self._build(0, self.n)
+
+    def _node(self, dim, value, start, end):
+        for lst, v in ((self._dim, dim), (self._value, value),
+                       (self._left, -1), (self._right, -1),
+                       (self._start, start), (self._end, end)):
+            lst.append(v)
+        return len(self._dim) - 1
+
+    def _build(self, start, end):
+        data, idx = self.data, self.indices
+        if end - start <= self.leafsize:
+            return self._node(-1, 0.0, start, end)
+        pts = idx[start:end]
+        spans = [max(c) - min(c) for c in zip(*(data[i] for i in pts))]
+        dim = max(range(self.m), key=spans.__getitem__)
+        if spans[dim] == 0:
+            return self._node(-1, 0.0, start, end)
+        pts.sort(key=lambda i: data[i][dim])
+        idx[start:end] = pts
+        coords = [data[i][dim] for i in pts]
+        # Split at the median, keeping equal coordinates on one side so that
+        # "coord <= value goes left" holds exactly.
+        value = coords[len(coords) // 2 - 1]
+        mid = bisect.bisect_right(coords, value)
+        if mid == len(coords):
+            mid = bisect.bisect_left(coords, value)
+            value = coords[mid - 1]
+        mid += start
+        node = self._node(dim, value, start, end)
+        self._left[node] = self._build(start, mid)
+        self._right[node] = self._build(mid, end)
+        return node
+
+    def _query_one(self, x, k, dist, bound):
+        # Max-heap of (-distance, -index) holding the best k so far; only
+        # points strictly closer than ``worst`` can enter it.
+        heap = []
+        worst = bound
+        data, idx = self.data, self.indices
+        stack = [(0, 0.0)]
+        while stack:
+            node, plane = stack.pop()
+            if plane >= worst:
+                continue
+            dim = self._dim[node]
+            if dim < 0:
+                for i in idx[self._start[node]:self._end[node]]:
+                    d = dist(x, data[i])
+                    if d < worst:
+                        if len(heap) == k:
+                            heapq.heapreplace(heap, (-d, -i))
+                        else:
+                            heapq.heappush(heap, (-d, -i))
+                        if len(heap) == k:
+                            worst = -heap[0][0]
+                continue
+            diff = x[dim] - self._value[node]
+            near, far = ((self._left[node], self._right[node]) if diff <= 0
+                         else (self._right[node], self._left[node]))
+            stack.append((far, max(plane, abs(diff))))
+            stack.append((near, plane))
+        return sorted((-d, -i) for d, i in heap)
+
+    def query(self, x, k=1, p=2, distance_upper_bound=math.inf, workers=None):
+        """``k`` nearest neighbours of each query point.
+
+        ``p`` selects the Minkowski norm (1, 2 or inf). Returns
+        ``(distances, indices)``: scalars per query for ``k == 1``, lists of
+        length ``k`` otherwise, padded with ``inf`` and ``-1`` when fewer
+        points lie within ``distance_upper_bound``. A 2-D ``x`` is a batch.
+        """
+        if k < 1:
+            raise ValueError('k must be at least 1')
+        queries, single = _queries(x)
+        if self.n and queries and len(queries[0]) != self.m:
+            raise ValueError('query points must have %d coordinates' % self.m)
+        dist = _minkowski(p)
+        if not self.n:
+            return _knn_result([[] for _ in queries], k, single)
+
+        def kernel(lo, hi):
+            return [self._query_one(queries[q], k, dist, distance_upper_bound)
+                    for q in range(lo, hi)]
+
+        return _knn_result(_run_blocks(len(queries), workers, kernel), k, single)
+
+    def query_ball_point(self, x, r, p=2):
+        """Sorted indices of the points within distance ``r`` of ``x``."""
+        queries, single = _queries(x)
+        dist = _minkowski(p)
+        out = []
+        for q in queries:
+            found = []
+            stack = [0] if self.n else []
+            while stack:
+                node = stack.pop()
+                dim = self._dim[node]
+                if dim < 0:
+                    found.extend(i for i in self.indices[
+                        self._start[node]:self._end[node]]
+                        if dist(q, self.data[i]) <= r)
+                    continue
+                diff = q[dim] - self._value[node]
+                if diff <= r:
+                    stack.append(self._left[node])
+                if diff >= -r:
+                    stack.append(self._right[node])
+            out.append(sorted(found))
+        return out[0] if single else out
+
+
+class IVFFlat:
+    """Approximate nearest neighbours with an inverted-file index.
+
+    ``nlist`` k-means centroids (``n_iter`` Lloyd iterations from a seeded
+    random sample) partition the rows of ``data``; each centroid keeps the
+    list of rows assigned to it. `query` compares against the centroids,
+    then scans exactly only the ``nprobe`` closest lists, trading recall
+    for speed. ``nprobe == nlist`` is exact.
+    """
+
+    def __init__(self, data, nlist=100, n_iter=10, seed=None):
+        self.data = _rows(data, 'data')
+        n = len(self.data)
+        if not n:
+            raise ValueError('IVFFlat needs at least one data row')
+        if not 1 <= nlist <= n:
+            raise ValueError('nlist must be between 1 and the number of rows')
+        rng = random.Random(seed)
+        self.centroids = [list(self.data[i]) for i in rng.sample(range(n), nlist)]
+        for _ in range(n_iter):
+            assign = self._assign(self.data)
+            sums = [None] * nlist
+            counts = [0] * nlist
+            for row, c in zip(self.data, assign):
+                sums[c] = list(row) if sums[c] is None else list(
+                    map(operator.add, sums[c], row))
+                counts[c] += 1
+            moved = False
+            for c in range(nlist):
+                if counts[c]:
+                    new = [v / counts[c] for v in sums[c]]
+                    moved |= new != self.centroids[c]
+                    self.centroids[c] = new
+            if not moved:
+                break
+        self.lists = [[] for _ in range(nlist)]
+        for i, c in enumerate(self._assign(self.data)):
+            self.lists[c].append(i)
+
+    def _assign(self, rows):
+        cents = self.centroids
+        dist = math.dist
+        return [min(range(len(cents)), key=lambda c: dist(r, cents[c]))
+                for r in rows]
+
+    def query(self, x, k=1, nprobe=1, workers=None):
+        """Approximate ``k`` nearest rows (euclidean) for each query.
+
+        Returns ``(distances, indices)`` shaped like `KDTree.query`.
+        """
+        queries, single = _queries(x)
+        cents, data, lists = self.centroids, self.data, self.lists
+        nprobe = min(nprobe, len(cents))
+        dist = math.dist
+
+        def kernel(lo, hi):
+            out = []
+            for q in queries[lo:hi]:
+                cd = [dist(q, c) for c in cents]
+                probe = heapq.nsmallest(nprobe, range(len(cents)),
+                                        key=cd.__getitem__)
+                cand = [i for c in probe for i in lists[c]]
+                out.append(heapq.nsmallest(
+                    k, ((dist(q, data[i]), i) for i in cand)))
+            return out
+
+        return _knn_result(_run_blocks(len(queries), workers, kernel), k, single)
@@ -0,0 +1,261 @@
+"""String arrays over contiguous UTF-8 buffers.
+
+`StringArray` uses the Arrow variable-length layout: one ``bytes`` buffer
+holding every string back to back, plus an int64 ``offsets`` array where
+element ``i`` spans ``data[offsets[i]:offsets[i + 1]]``. `FixedStringArray`
+stores each element in a ``width``-byte slot padded with NUL bytes, like
+NumPy's ``S`` dtype but UTF-8 encoded (so strings cannot contain NUL).
+
+Both cost a few bytes per element instead of a full `str` object, and the
+operations run on the shared buffer: `bytes.startswith` and `bytes.find`
+take start/end bounds, so no per-element slices are made for them, and on
+all-ASCII data `lower` rewrites the whole buffer in one call. Because UTF-8
+byte order equals code point order, sorting compares raw bytes.
+"""
+
+from array import array
+from itertools import accumulate
+
+
+def _encode_all(values):
+    out = []
+    for v in values:
+        if not isinstance(v, str):
+            raise TypeError('expected str, got %s' % type(v).__name__)
+        out.append(v.encode('utf-8'))
+    return out
+
+
+def _pack(encoded):
+    return (array('q', accumulate(map(len, encoded), initial=0)),
+            b''.join(encoded))
+
+
+class _StringBase:
+    # Subclasses provide self._data (bytes) and _spans() -> (starts, ends).
+
+    def __len__(self):
+        return len(self._spans()[0])
+
+    @property
+    def nbytes(self):
+        raise NotImplementedError
+
+    def _raw(self):
+        data = self._data
+        starts, ends = self._spans()
+        return [data[s:e] for s, e in zip(starts, ends)]
+
+    def tolist(self):
+        return [b.decode('utf-8') for b in self._raw()]
+
+    def __iter__(self):
+        return iter(self.tolist())
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            return self.take(range(*key.indices(len(self))))
+        starts, ends = self._spans()
+        return self._data[starts[key]:ends[key]].decode('utf-8')
+
+    def take(self, indices):
+        raise NotImplementedError
+
+    def _indices(self, indices):
+        n = len(self)
+        out = [i + n if i < 0 else i for i in indices]
+        if any(not 0 <= i < n for i in out):
+            raise IndexError('index out of range')
+        return out
+
+    def str_len(self):
+        """Length of each element in characters."""
+        starts, ends = self._spans()
+        if self._data.isascii():
+            return [e - s for s, e in zip(starts, ends)]
+        return [len(b.decode('utf-8')) for b in self._raw()]
+
+    def startswith(self, prefix):
+        p = prefix.encode('utf-8')
+        starts, ends = self._spans()
+        return list(map(self._data.startswith, [p] * len(starts), starts, ends))
+
+    def endswith(self, suffix):
+        p = suffix.encode('utf-8')
+        starts, ends = self._spans()
+        return list(map(self._data.endswith, [p] * len(starts), starts, ends))
+
+    def find(self, sub):
+        """Character index of the first ``sub`` in each element, or -1."""
+        p = sub.encode('utf-8')
+        data = self._data
+        starts, ends = self._spans()
+        pos = list(map(data.find, [p] * len(starts), starts, ends))
+        if data.isascii():
+            return [-1 if k < 0 else k - s for k, s in zip(pos, starts)]
+        return [-1 if k < 0 else len(data[s:k].decode('utf-8'))
+                for k, s in zip(pos, starts)]
+
+    def __contains__(self, value):
+        return any(self == value)
+
+    def __eq__(self, other):
+        data = self._data
+        starts, ends = self._spans()
+        if isinstance(other, str):
+            b = other.encode('utf-8')
+            n = len(b)
+            return [e - s == n and data[s:e] == b for s, e in zip(starts, ends)]
+        if isinstance(other, _StringBase):
+            if len(other) != len(self):
+                raise ValueError('operands have different lengths')
+            return list(map(bytes.__eq__, self._raw(), other._raw()))
+        return NotImplemented
+
+    def __ne__(self, other):
+        eq = self.__eq__(other)
+        return eq if eq is NotImplemented else [not v for v in eq]
+
+    __hash__ = None
+
+    def hash(self):
+        """Hash of each element's UTF-8 bytes.
+
+        Values are stable within one process (like `hash`), which is what
+        hash joins and group-bys need.
+        """
+        return list(map(hash, self._raw()))
+
+    def argsort(self):
+        """Indices that sort the array by code point (stable)."""
+        raw = self._raw()
+        return sorted(range(len(raw)), key=raw.__getitem__)
+
+    def sort(self):
+        """Sorted copy of the array."""
+        return self.take(self.argsort())
+
+    def __repr__(self):
+        return '%s(%r)' % (type(self).__name__, self.tolist())
+
+
+class StringArray(_StringBase):
+    """Variable-length UTF-8 strings in Arrow ``offsets`` + ``data`` layout."""
+
+    def __init__(self, values=()):
+        if isinstance(values, _StringBase):
+            encoded = values._raw()
+        else:
+            encoded = _encode_all(values)
+        self.offsets, self._data = _pack(encoded)
+
+    @classmethod
+    def frombuffers(cls, offsets, data):
+        """Wrap existing Arrow-style ``offsets`` and UTF-8 ``data`` buffers.
+
+        ``offsets`` may be any int sequence (an ``array('q')`` or a memoryview
+        over an int32/int64 buffer is kept as is). ``data`` is used directly
+        when it is ``bytes``; other bytes-like objects are copied once.
+        """
+        if len(offsets) == 0 or offsets[0] < 0 or offsets[-1] > len(data):
+            raise ValueError('offsets do not fit the data buffer')
+        out = cls.__new__(cls)
+        out._data = data if isinstance(data, bytes) else bytes(data)
+        out.offsets = offsets
+        return out
+
+    @property
+    def data(self):
+        return self._data
+
+    @property
+    def nbytes(self):
+        return len(self._data) + len(self.offsets) * getattr(self.offsets,
+                                                           'itemsize', 8)
+
+    def _spans(self):
+        o = self.offsets
+        return o[:-1], o[1:]
+
+    def take(self, indices):
+        data, o = self._data, self.offsets
+        return StringArray.frombuffers(
+            *_pack([data[o[i]:o[i + 1]] for i in self._indices(indices)]))
+
+    def lower(self):
+        if self._data.isascii():
+            return StringArray.frombuffers(self.offsets, self._data.lower())
+        return StringArray([s.lower() for s in self.tolist()])
+
+    def upper(self):
+        if self._data.isascii():
+            return StringArray.frombuffers(self.offsets, self._data.upper())
+        return StringArray([s.upper() for s in self.tolist()])
+
+
+class FixedStringArray(_StringBase):
+    """UTF-8 strings in ``width``-byte NUL-padded slots.
+
+    ``width`` defaults to the longest encoded value; longer values raise.
+    """
+
+    def __init__(self, values=(), width=None):
+        if isinstance(values, _StringBase):
+            encoded = values._raw()
+        else:
+            encoded = _encode_all(values)
+        longest = max(map(len, encoded), default=0)
+        if width is None:
+            width = max(longest, 1)
+        elif longest > width:
+            raise ValueError('value of %d bytes does not fit width %d'
+                             % (longest, width))
+        self.width = width
+        self._data = b''.join(b.ljust(width, b'\0') for b in encoded)
+        self._cache = None
+
+    @classmethod
+    def frombuffer(cls, buffer, width):
+        """Wrap ``width``-byte slots; non-``bytes`` buffers are copied once."""
+        if width <= 0 or len(buffer) % width:
+            raise ValueError('buffer length is not a multiple of width')
+        out = cls.__new__(cls)
+        out.width = width
+        out._data = buffer if isinstance(buffer, bytes) else bytes(buffer)
+        out._cache = None
+        return out
+
+    @property
+    def data(self):
+        return self._data
+
+    @property
+    def nbytes(self):
+        return len(self._data)
+
+    def _spans(self):
+        # Element ends are the first NUL in each slot, found once and cached.
+        if self._cache is None:
+            w = self.width
+            starts = range(0, len(self._data), w)
+            stops = [s + w for s in starts]
+            ends = [s + w if k < 0 else k for k, s in zip(
+                map(self._data.find, [b'\0'] * len(starts), starts, stops),
+                starts)]
+            self._cache = starts, ends
+        return self._cache
+
+    def take(self, indices):
+        data, w = self._data, self.width
+        return FixedStringArray.frombuffer(
+            b''.join([data[i * w:i * w + w] for i in self._indices(indices)]), w)
+
+    def lower(self):
+        if self._data.isascii():
+            return FixedStringArray.frombuffer(self._data.lower(), self.width)
+        return FixedStringArray([s.lower() for s in self.tolist()])
+
+    def upper(self):
+        if self._data.isascii():
+            return FixedStringArray.frombuffer(self._data.upper(), self.width)
+        return FixedStringArray([s.upper() for s in self.tolist()])
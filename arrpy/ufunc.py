@@ -0,0 +1,412 @@
+"""Universal functions: elementwise and generalized kernels with broadcasting.
+
+A `ufunc` wraps a scalar kernel ``f(x, y, ...)`` and applies it across
+nested-list arrays with NumPy broadcasting, optional ``out=`` arrays and an
+optional result ``dtype``. A `gufunc` does the same for kernels over core
+sub-arrays described by a signature such as ``'(n),(n)->()'``: the trailing
+core dimensions go to the kernel whole and the leading loop dimensions are
+broadcast.
+
+Broadcasting expands each operand to one flat row-major list of the result
+shape, using slice repetition and `itertools.repeat` rather than index
+arithmetic per element, and the kernel then runs as a single
+``map(f, *operands)``. A kernel registered with ``vectorized=True``
+receives those flat lists directly and returns the flat result, which is
+the hook for code that processes a whole array per call (a ``ctypes``
+function, an `array`-based routine, ...).
+
+Binary ufuncs also provide NumPy's `ufunc.reduce`, `ufunc.accumulate`,
+`ufunc.reduceat` and `ufunc.outer`. Along the last axis each lane is folded
+with `functools.reduce` or `itertools.accumulate`; along an outer axis the
+kernel instead combines whole contiguous blocks of the trailing dimensions
+per step, so the per-element work stays inside ``map``.
+
+`register_ufunc` and `register_gufunc` are decorators that build the
+wrapper and record it by name in `UFUNCS`::
+
+    @register_ufunc(nin=2)
+    def hypot2(x, y):
+        return x * x + y * y
+
+    @register_gufunc('(n),(n)->()')
+    def dot(a, b):
+        return math.fsum(map(operator.mul, a, b))
+"""
+
+import functools
+import math
+import operator
+import re
+from itertools import chain, repeat
+
+from .core import ieee_div, normalize_axis, ravel, reshape
+from .core import shape as _shape
+from .cumulative import _scan
+from . import dtypes as _dtypes
+
+UFUNCS = {}
+
+
+def broadcast_shapes(*shapes):
+    """Result shape of broadcasting ``shapes`` together (NumPy rules)."""
+    ndim = max(map(len, shapes), default=0)
+    out = []
+    for axis in range(ndim):
+        size = 1
+        for s in shapes:
+            k = axis - (ndim - len(s))
+            if k < 0 or s[k] == 1:
+                continue
+            if size != 1 and s[k] != size:
+                raise ValueError('operands could not be broadcast together with '
+                                 'shapes %s' % ' '.join(map(str, shapes)))
+            size = s[k]
+        out.append(size)
+    return tuple(out)
+
+
+def _flatten(a, depth):
+    # Row-major list of the items ``depth`` levels into nested list ``a``.
+    flat = [a]
+    for _ in range(depth):
+        flat = [x for row in flat for x in row]
+    return flat
+
+
+def _broadcast_flat(flat, dims, target):
+    """Expand row-major ``flat`` of shape ``dims`` to shape ``target``."""
+    dims = (1,) * (len(target) - len(dims)) + tuple(dims)
+    inner = 1
+    for axis in range(len(target) - 1, -1, -1):
+        t = target[axis]
+        if dims[axis] == 1 and t != 1:
+            if inner == 1:
+                flat = list(chain.from_iterable(map(repeat, flat, repeat(t))))
+            else:
+                flat = [x for i in range(0, len(flat), inner)
+                        for x in flat[i:i + inner] * t]
+        inner *= t
+    return flat
+
+
+def _write_out(out, flat, dims):
+    # Copy ``flat`` into the existing nested list ``out`` of shape ``dims``.
+    if not dims:
+        raise ValueError('out= needs an array, not a scalar result')
+    if _shape(out)[:len(dims)] != dims:
+        raise ValueError('out has shape %r, expected %r' % (_shape(out), dims))
+    n = dims[-1]
+    for i, row in enumerate(_flatten(out, len(dims) - 1)):
+        row[:] = flat[i * n:(i + 1) * n]
+    return out
+
+
+def _finish(flat, dims, out, dtype, casting):
+    if dtype is not None:
+        flat = _dtypes.astype(flat, dtype, casting=casting)
+    if out is not None:
+        return _write_out(out, flat, dims)
+    return reshape(flat, dims) if dims else flat[0]
+
+
+class ufunc:
+    """Elementwise function of ``nin`` arrays producing ``nout`` arrays.
+
+    ``func`` takes ``nin`` scalars and returns a scalar (or a ``nout``-tuple).
+    With ``vectorized=True`` it instead takes ``nin`` equal-length flat lists
+    and returns a flat list (or a ``nout``-tuple of lists). ``identity`` is
+    the value of an empty reduction, when there is one.
+    """
+
+    def __init__(self, func, nin, nout=1, name=None, identity=None,
+                 vectorized=False):
+        if nin < 1 or nout < 1:
+            raise ValueError('a ufunc needs at least one input and one output')
+        self.func = func
+        self.nin = nin
+        self.nout = nout
+        self.identity = identity
+        self.vectorized = vectorized
+        self.__name__ = name or getattr(func, '__name__', 'ufunc')
+        self.__doc__ = getattr(func, '__doc__', None)
+
+    @property
+    def nargs(self):
+        return self.nin + self.nout
+
+    def _kernel(self, flats):
+        if self.vectorized:
+            result = self.func(*flats)
+        else:
+            result = list(map(self.func, *flats))
+            if self.nout > 1:
+                columns = [list(c) for c in zip(*result)]
+                result = tuple(columns or [[] for _ in range(self.nout)])
+        return result
+
+    def __call__(self, *args, out=None, dtype=None, casting='same_kind'):
+        if len(args) != self.nin:
+            raise TypeError('%s() takes %d positional arguments but %d were given'
+                            % (self.__name__, self.nin, len(args)))
+        shapes = [_shape(a) for a in args]
+        dims = broadcast_shapes(*shapes)
+        flats = [_broadcast_flat(_flatten(a, len(s)), s, dims)
+                 for a, s in zip(args, shapes)]
+        result = self._kernel(flats)
+        if self.nout == 1:
+            return _finish(result, dims, out, dtype, casting)
+        outs = out if out is not None else (None,) * self.nout
+        if len(outs) != self.nout:
+            raise ValueError('out must be a tuple of %d arrays' % self.nout)
+        return tuple(_finish(r, dims, o, dtype, casting)
+                     for r, o in zip(result, outs))
+
+    # -- methods of binary ufuncs ------------------------------------------
+
+    def _binary_only(self, method):
+        if self.nin != 2 or self.nout != 1:
+            raise ValueError('%s only supported for binary functions' % method)
+
+    def _scalar(self):
+        if self.vectorized:
+            return lambda x, y: self.func([x], [y])[0]
+        return self.func
+
+    def _combine(self, acc, block):
+        if self.vectorized:
+            return list(self.func(acc, block))
+        return list(map(self.func, acc, block))
+
+    def _segments(self, flat, dims, axis, segments, initial):
+        # Reduce rows ``start:stop`` along ``axis`` for every (start, stop);
+        # the reduced axis of the result has one entry per segment.
+        n = dims[axis]
+        inner = math.prod(dims[axis + 1:])
+        out = []
+        scalar = self._scalar()
+        for outer in range(math.prod(dims[:axis])):
+            base = outer * n * inner
+            if inner == 1:
+                lane = flat[base:base + n]
+                if initial is None:
+                    out.extend(functools.reduce(scalar, lane[s:e])
+                               for s, e in segments)
+                else:
+                    out.extend(functools.reduce(scalar, lane[s:e], initial)
+                               for s, e in segments)
+                continue
+            for s, e in segments:
+                if initial is None:
+                    lo = base + s * inner
+                    acc = flat[lo:lo + inner]
+                    s += 1
+                else:
+                    acc = [initial] * inner
+                for i in range(s, e):
+                    lo = base + i * inner
+                    acc = self._combine(acc, flat[lo:lo + inner])
+                out.extend(acc)
+        return out
+
+    def reduce(self, a, axis=0, initial=None, keepdims=False):
+        """Fold ``a`` along ``axis`` (``None``: all elements) with this ufunc.
+
+        ``add.reduce`` is a sum, ``maximum.reduce`` a max, and so on. An
+        empty axis gives ``initial`` or the ufunc's identity.
+        """
+        self._binary_only('reduce')
+        dims = _shape(a)
+        if axis is None:
+            flat, dims, axis = ravel(a), (math.prod(dims),), 0
+            keep = (1,) * len(_shape(a))
+        else:
+            axis = normalize_axis(axis, len(dims))
+            flat = ravel(a)
+            keep = dims[:axis] + (1,) + dims[axis + 1:]
+        if initial is None and dims[axis] == 0:
+            if self.identity is None:
+                raise ValueError('zero-size array to reduction operation %s '
+                                 'which has no identity' % self.__name__)
+            initial = self.identity
+        out = self._segments(flat, dims, axis, [(0, dims[axis])], initial)
+        if keepdims:
+            return reshape(out, keep)
+        rest = dims[:axis] + dims[axis + 1:]
+        return reshape(out, rest) if rest else out[0]
+
+    def accumulate(self, a, axis=0):
+        """Running reduction along ``axis``, the same shape as ``a``."""
+        self._binary_only('accumulate')
+        return _scan(a, axis, self._scalar())
+
+    def reduceat(self, a, indices, axis=0):
+        """Reduce the slices ``indices[i]:indices[i + 1]`` along ``axis``.
+
+        Follows NumPy: the last slice runs to the end of the axis, and where
+        ``indices[i] >= indices[i + 1]`` the result is just ``a[indices[i]]``.
+        For CSR-style offsets ``indptr``, pass ``indptr[:-1]``.
+        """
+        self._binary_only('reduceat')
+        dims = _shape(a)
+        axis = normalize_axis(axis, len(dims))
+        n = dims[axis]
+        indices = list(indices)
+        if any(not 0 <= i < n for i in indices):
+            raise IndexError('index out of bounds for axis of length %d' % n)
+        segments = [(s, e if e > s else s + 1)
+                    for s, e in zip(indices, indices[1:] + [n])]
+        out = self._segments(ravel(a), dims, axis, segments, None)
+        return reshape(out, dims[:axis] + (len(indices),) + dims[axis + 1:])
+
+    def outer(self, a, b):
+        """``f(a[i...], b[j...])`` for every pair; shape ``a.shape + b.shape``."""
+        self._binary_only('outer')
+        da, db = _shape(a), _shape(b)
+        fa, fb = ravel(a), ravel(b)
+        left = list(chain.from_iterable(map(repeat, fa, repeat(len(fb)))))
+        out = self._kernel([left, fb * len(fa)])
+        dims = da + db
+        return reshape(out, dims) if dims else out[0]
+
+    def __repr__(self):
+        return '<ufunc %r>' % self.__name__
+
+
+_CORE = re.compile(r'\(([^()]*)\)')
+_CORES = re.compile(r'^\([\w,]*\)(,\([\w,]*\))*$')
+
+
+def _parse_signature(signature):
+    sig = signature.replace(' ', '')
+    if '->' not in sig:
+        raise ValueError('invalid gufunc signature %r' % signature)
+    ins, outs = sig.split('->')
+
+    def parse(part):
+        if not _CORES.match(part):
+            raise ValueError('invalid gufunc signature %r' % signature)
+        return [tuple(d for d in g.split(',') if d) for g in _CORE.findall(part)]
+
+    return parse(ins), parse(outs)
+
+
+class gufunc:
+    """Generalized ufunc over core sub-arrays, e.g. ``'(m,n),(n)->(m)'``.
+
+    ``func`` receives one nested list per input holding exactly its core
+    dimensions (a scalar for ``()``) and returns the output core (a tuple of
+    cores when there are several outputs). Loop dimensions in front of the
+    cores broadcast like `ufunc` operands, and every use of a core dimension
+    name must have the same size.
+    """
+
+    def __init__(self, func, signature, name=None):
+        self.func = func
+        self.signature = signature
+        self.core_in, self.core_out = _parse_signature(signature)
+        self.nin = len(self.core_in)
+        self.nout = len(self.core_out)
+        self.__name__ = name or getattr(func, '__name__', 'gufunc')
+        self.__doc__ = getattr(func, '__doc__', None)
+
+    def __call__(self, *args, out=None):
+        if len(args) != self.nin:
+            raise TypeError('%s() takes %d positional arguments but %d were given'
+                            % (self.__name__, self.nin, len(args)))
+        sizes = {}
+        loop_shapes = []
+        for a, core in zip(args, self.core_in):
+            dims = _shape(a)
+            if len(dims) < len(core):
+                raise ValueError('%s: input has %d dimensions, core signature '
+                                 '%s needs %d' % (self.__name__, len(dims),
+                                                  '(%s)' % ','.join(core),
+                                                  len(core)))
+            split = len(dims) - len(core)
+            for name, size in zip(core, dims[split:]):
+                if sizes.setdefault(name, size) != size:
+                    raise ValueError('%s: core dimension %r has mismatched sizes '
+                                     '%d and %d' % (self.__name__, name,
+                                                    sizes[name], size))
+            loop_shapes.append(dims[:split])
+        loop = broadcast_shapes(*loop_shapes)
+        items = [_broadcast_flat(_flatten(a, len(s)), s, loop)
+                 for a, s in zip(args, loop_shapes)]
+        results = list(map(self.func, *items))
+        if self.nout == 1:
+            return self._finish(results, loop, out)
+        outs = out if out is not None else (None,) * self.nout
+        return tuple(self._finish(list(r), loop, o)
+                     for r, o in zip(zip(*results), outs))
+
+    def _finish(self, results, loop, out):
+        if out is None:
+            return reshape(results, loop) if loop else results[0]
+        if loop:
+            return _write_out(out, results, loop)
+        return _write_core(out, results[0])
+
+    def __repr__(self):
+        return '<gufunc %r %s>' % (self.__name__, self.signature)
+
+
+def _write_core(out, core):
+    # A loop-free gufunc result copied into ``out`` (same nested shape).
+    if not isinstance(out, list) or len(out) != len(core):
+        raise ValueError('out does not match the result shape')
+    out[:] = core
+    return out
+
+
+def _register(obj):
+    UFUNCS[obj.__name__] = obj
+    return obj
+
+
+def register_ufunc(nin=None, nout=1, name=None, identity=None, vectorized=False):
+    """Decorator turning a scalar (or whole-list) kernel into a `ufunc`.
+
+    ``nin`` defaults to the kernel's number of positional parameters.
+    """
+    def wrap(func):
+        n = nin if nin is not None else func.__code__.co_argcount
+        return _register(ufunc(func, n, nout, name=name, identity=identity,
+                               vectorized=vectorized))
+    return wrap
+
+
+def register_gufunc(signature, name=None):
+    """Decorator turning a core-array kernel into a `gufunc`."""
+    def wrap(func):
+        return _register(gufunc(func, signature, name=name))
+    return wrap
+
+
+def frompyfunc(func, nin, nout, identity=None):
+    """Unregistered `ufunc` for a scalar function, as in NumPy."""
+    return ufunc(func, nin, nout, identity=identity)
+
+
+def _maximum(x, y):
+    # NaN-propagating, unlike the builtin max.
+    return x if x >= y or x != x else y
+
+
+def _minimum(x, y):
+    return x if x <= y or x != x else y
+
+
+add = _register(ufunc(operator.add, 2, name='add', identity=0))
+subtract = _register(ufunc(operator.sub, 2, name='subtract'))
+multiply = _register(ufunc(operator.mul, 2, name='multiply', identity=1))
+divide = true_divide = _register(ufunc(ieee_div, 2, name='divide'))
+floor_divide = _register(ufunc(operator.floordiv, 2, name='floor_divide'))
+power = _register(ufunc(operator.pow, 2, name='power'))
+maximum = _register(ufunc(_maximum, 2, name='maximum'))
+minimum = _register(ufunc(_minimum, 2, name='minimum'))
+logical_and = _register(ufunc(lambda x, y: bool(x and y), 2,
+                              name='logical_and', identity=True))
+logical_or = _register(ufunc(lambda x, y: bool(x or y), 2,
+                             name='logical_or', identity=False))
+negative = _register(ufunc(operator.neg, 1, name='negative'))
+absolute = _register(ufunc(abs, 1, name='absolute'))
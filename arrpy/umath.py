@@ -0,0 +1,186 @@
+"""Elementwise transcendental functions over nested lists.
+
+Each function accepts a scalar, a flat list or a nested list and returns the
+same shape. The whole array goes through one ``map(math.<f>, flat)``: the
+loop runs in C and calls the platform libm directly, with no Python frame or
+attribute lookup per element.
+
+By default results follow IEEE 754 / NumPy for special inputs:
+``log(0) == -inf``, ``log(-1)`` and ``sqrt(-1)`` are NaN, ``exp(1000) == inf``.
+Python's `math` raises on those inputs, so an array containing one is
+recomputed element by element with the IEEE fallback. Passing ``fast=True``
+skips that fallback: out-of-domain inputs raise `ValueError` or
+`OverflowError` as `math` does, which suits inputs already known to be in
+range.
+
+Accuracy is that of the underlying implementation. Maximum errors in units
+in the last place for float64 (glibc 2.28+ on x86-64, from its
+``libm-test-ulps``; other libms differ):
+
+    ======================================  =========
+    sqrt                                    0.5 (correctly rounded)
+    exp, log, log2, pow, sin, cos           1
+    expm1, log1p, tan, arcsin, arctan2      1
+    sinh, tanh, erf                         2
+    erfc                                    5
+    rsqrt (``1 / sqrt``, two roundings)     1.5
+    gamma, lgamma (CPython's Lanczos code)  10
+    ======================================  =========
+"""
+
+import math
+import operator
+from itertools import repeat
+
+from .core import ravel, reshape
+from .core import shape as _shape
+
+_ERRORS = (ValueError, OverflowError, ZeroDivisionError)
+
+
+def _nan(x):
+    return math.nan
+
+
+def _inf(x):
+    return math.inf
+
+
+def _signed_inf(x):
+    return math.copysign(math.inf, x)
+
+
+def _log_domain(x):
+    return -math.inf if x == 0 else math.nan
+
+
+def _log1p_domain(x):
+    return -math.inf if x == -1 else math.nan
+
+
+def _gamma_domain(x):
+    # Poles: +-inf at signed zero, NaN at negative integers and -inf.
+    return math.copysign(math.inf, x) if x == 0 else math.nan
+
+
+def _rsqrt(x):
+    return 1.0 / math.sqrt(x)
+
+
+def _rsqrt_domain(x):
+    return math.copysign(math.inf, x) if x == 0 else math.nan
+
+
+def _guard(func, on_domain, on_overflow):
+    # Scalar version of ``func`` that maps math's exceptions to IEEE values.
+    def guarded(x):
+        try:
+            return func(x)
+        except OverflowError:
+            return on_overflow(x)
+        except (ValueError, ZeroDivisionError):
+            return on_domain(x)
+    return guarded
+
+
+def _apply(x, kernel, scalar, fast):
+    dims = _shape(x)
+    flat = x if len(dims) == 1 else ravel(x)
+    try:
+        out = kernel(flat)
+    except _ERRORS:
+        if fast:
+            raise
+        out = list(map(scalar, flat))
+    if len(dims) == 1:
+        return out
+    return reshape(out, dims) if dims else out[0]
+
+
+def _unary(name, func, on_domain=_nan, on_overflow=_inf, kernel=None):
+    if kernel is None:
+        def kernel(flat):
+            return list(map(func, flat))
+    scalar = _guard(func, on_domain, on_overflow)
+
+    def ufunc(x, fast=False):
+        return _apply(x, kernel, scalar, fast)
+
+    ufunc.__name__ = ufunc.__qualname__ = name
+    ufunc.__doc__ = ('Elementwise %s; ``fast=True`` skips IEEE special-value '
+                     'handling.' % name)
+    return ufunc
+
+
+exp = _unary('exp', math.exp)
+expm1 = _unary('expm1', math.expm1)
+log = _unary('log', math.log, _log_domain)
+log1p = _unary('log1p', math.log1p, _log1p_domain)
+log2 = _unary('log2', math.log2, _log_domain)
+log10 = _unary('log10', math.log10, _log_domain)
+sqrt = _unary('sqrt', math.sqrt)
+rsqrt = _unary('rsqrt', _rsqrt, _rsqrt_domain, kernel=lambda flat: list(
+    map(operator.truediv, repeat(1.0), map(math.sqrt, flat))))
+sin = _unary('sin', math.sin)
+cos = _unary('cos', math.cos)
+tan = _unary('tan', math.tan)
+arcsin = _unary('arcsin', math.asin)
+arccos = _unary('arccos', math.acos)
+arctan = _unary('arctan', math.atan)
+sinh = _unary('sinh', math.sinh, on_overflow=_signed_inf)
+cosh = _unary('cosh', math.cosh)
+tanh = _unary('tanh', math.tanh)
+erf = _unary('erf', math.erf)
+erfc = _unary('erfc', math.erfc)
+gamma = _unary('gamma', math.gamma, _gamma_domain)
+lgamma = _unary('lgamma', math.lgamma, _inf)
+
+
+def _binary_operands(x, y):
+    dx, dy = _shape(x), _shape(y)
+    fx, fy = ravel(x), ravel(y)
+    if not dx:
+        return repeat(fx[0], len(fy)), fy, dy
+    if not dy:
+        return fx, repeat(fy[0], len(fx)), dx
+    if dx != dy:
+        raise ValueError('operands could not be broadcast together with '
+                         'shapes %r %r' % (dx, dy))
+    return fx, fy, dx
+
+
+def _binary(x, y, func, scalar, fast):
+    fx, fy, dims = _binary_operands(x, y)
+    fx, fy = list(fx), list(fy)
+    try:
+        out = list(map(func, fx, fy))
+    except _ERRORS:
+        if fast:
+            raise
+        out = list(map(scalar, fx, fy))
+    return reshape(out, dims) if dims else out[0]
+
+
+def arctan2(y, x, fast=False):
+    """Elementwise ``atan2(y, x)``; a scalar operand is broadcast."""
+    return _binary(y, x, math.atan2, math.atan2, fast)
+
+
+def _is_odd_integer(y):
+    return math.isfinite(y) and y == int(y) and int(y) % 2 == 1
+
+
+def _ieee_pow(x, y):
+    try:
+        return math.pow(x, y)
+    except OverflowError:
+        return -math.inf if x < 0 and _is_odd_integer(y) else math.inf
+    except ValueError:
+        if x == 0:  # zero to a negative power: a pole
+            return math.copysign(math.inf, x) if _is_odd_integer(y) else math.inf
+        return math.nan
+
+
+def power(x, y, fast=False):
+    """Elementwise ``x ** y`` with IEEE results; a scalar operand is broadcast."""
+    return _binary(x, y, math.pow, _ieee_pow, fast)
@@ -0,0 +1,169 @@
+"""Moving-window views and rolling aggregations.
+
+``rolling(a, window, axis).mean()`` and friends return one value per full
+window, so the result is ``window - 1`` shorter than ``a`` along ``axis``,
+lining up with `sliding_window_view`. Each statistic updates incrementally
+as the window slides instead of re-reducing every window:
+
+* sum and mean keep a running total,
+* var and std use a sliding Welford update of the mean and squared error,
+* min and max keep a monotonic deque of candidate indices,
+* median and quantile keep the window sorted, inserting and removing one
+  element per step by bisection.
+"""
+
+import bisect
+import math
+import operator
+from collections import deque
+from itertools import accumulate
+from numbers import Integral
+
+from .core import apply_along_axis, normalize_axis, ravel, reshape
+from .core import shape as _shape
+
+
+def sliding_window_view(x, window_shape, axis=None):
+    """All windows of ``window_shape`` over ``x``, as new trailing axes.
+
+    Follows NumPy: ``axis=None`` windows every axis, and each windowed axis
+    shrinks to ``n - w + 1``. The result is a nested-list copy.
+    """
+    dims = _shape(x)
+    flat = ravel(x)
+    ws = (window_shape,) if isinstance(window_shape, Integral) else tuple(window_shape)
+    if axis is None:
+        axes = tuple(range(len(dims)))
+    elif isinstance(axis, Integral):
+        axes = (axis,)
+    else:
+        axes = tuple(axis)
+    axes = tuple(normalize_axis(ax, len(dims)) for ax in axes)
+    if len(ws) != len(axes):
+        raise ValueError('window_shape must have one entry per windowed axis')
+    out_dims = list(dims)
+    for ax, w in zip(axes, ws):
+        if w < 0:
+            raise ValueError('window_shape cannot contain negative values')
+        if w > out_dims[ax]:
+            raise ValueError('window shape cannot be larger than input array shape')
+        out_dims[ax] -= w - 1
+    strides = [math.prod(dims[i + 1:]) for i in range(len(dims))]
+    full_dims = tuple(out_dims) + ws
+    offsets = [0]
+    for n, st in zip(full_dims, strides + [strides[ax] for ax in axes]):
+        offsets = [o + i * st for o in offsets for i in range(n)]
+    return reshape([flat[o] for o in offsets], full_dims)
+
+
+def _rolling_sum(lane, w):
+    total = sum(lane[:w])
+    return list(accumulate(map(operator.sub, lane[w:], lane[:-w]), initial=total))
+
+
+def _rolling_moments(lane, w, ddof):
+    # Sliding Welford: swap the oldest sample for the newest and update the
+    # mean and the sum of squared deviations without re-reducing.
+    mean = 0.0
+    m2 = 0.0
+    for k, x in enumerate(lane[:w], 1):
+        d = x - mean
+        mean += d / k
+        m2 += d * (x - mean)
+    denom = w - ddof
+    out = [max(m2, 0.0) / denom if denom > 0 else math.nan]
+    for old, new in zip(lane, lane[w:]):
+        d = new - old
+        prev = mean
+        mean += d / w
+        m2 += d * (new - mean + old - prev)
+        out.append(max(m2, 0.0) / denom if denom > 0 else math.nan)
+    return out
+
+
+def _rolling_extreme(lane, w, better):
+    # Monotonic deque of indices whose values are still window candidates;
+    # the front is always the current extreme.
+    out = []
+    dq = deque()
+    for i, x in enumerate(lane):
+        while dq and not better(lane[dq[-1]], x):
+            dq.pop()
+        dq.append(i)
+        if dq[0] <= i - w:
+            dq.popleft()
+        if i >= w - 1:
+            out.append(lane[dq[0]])
+    return out
+
+
+def _rolling_quantile(lane, w, q):
+    window = sorted(lane[:w])
+    pos = q * (w - 1)
+    lo = int(math.floor(pos))
+    hi = min(lo + 1, w - 1)
+    frac = pos - lo
+
+    def pick():
+        a = window[lo]
+        return a + (window[hi] - a) * frac if frac else a
+
+    out = [pick()]
+    for old, new in zip(lane, lane[w:]):
+        del window[bisect.bisect_left(window, old)]
+        bisect.insort(window, new)
+        out.append(pick())
+    return out
+
+
+class Rolling:
+    """Rolling aggregations over windows of ``window`` along ``axis``."""
+
+    def __init__(self, a, window, axis=-1):
+        dims = _shape(a)
+        if not dims:
+            raise ValueError('rolling requires at least one dimension')
+        self.axis = normalize_axis(axis, len(dims))
+        if not 1 <= window <= dims[self.axis]:
+            raise ValueError('window must be between 1 and the axis length')
+        self.window = int(window)
+        self._a = a
+
+    def _apply(self, func):
+        return apply_along_axis(func, self._a, self.axis)
+
+    def sum(self):
+        return self._apply(lambda lane: _rolling_sum(lane, self.window))
+
+    def mean(self):
+        w = self.window
+        return self._apply(lambda lane: [s / w for s in _rolling_sum(lane, w)])
+
+    def var(self, ddof=0):
+        return self._apply(lambda lane: _rolling_moments(lane, self.window, ddof))
+
+    def std(self, ddof=0):
+        return self._apply(lambda lane: [
+            math.sqrt(v) for v in _rolling_moments(lane, self.window, ddof)])
+
+    def min(self):
+        return self._apply(
+            lambda lane: _rolling_extreme(lane, self.window, operator.lt))
+
+    def max(self):
+        return self._apply(
+            lambda lane: _rolling_extreme(lane, self.window, operator.gt))
+
+    def median(self):
+        return self.quantile(0.5)
+
+    def quantile(self, q):
+        """``q``-th quantile of each window, interpolating linearly."""
+        if not 0.0 <= q <= 1.0:
+            raise ValueError('quantile must be in [0, 1]')
+        return self._apply(lambda lane: _rolling_quantile(lane, self.window, q))
+
+
+def rolling(a, window, axis=-1):
+    """Start a rolling computation; see `Rolling` for the statistics."""
+    return Rolling(a, window, axis)
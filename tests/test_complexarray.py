@@ -0,0 +1,87 @@
+import math
+from array import array
+
+import pytest
+
+from arrpy.complexarray import ComplexArray
+
+
+def test_interleaved_storage_and_views():
+    z = ComplexArray([1 + 2j, 3 - 4j])
+    assert len(z) == 2 and z.nbytes == 32
+    assert list(z.real) == [1.0, 3.0]
+    assert list(z.imag) == [2.0, -4.0]
+    z.real[0] = 5.0
+    assert z[0] == 5 + 2j
+    assert z[-1] == 3 - 4j
+    with pytest.raises(IndexError):
+        z[2]
+    with pytest.raises(TypeError):
+        ComplexArray([1], dtype='complex32')
+
+
+def test_complex64_rounds_components():
+    z = ComplexArray([0.1 + 0.1j], dtype='complex64')
+    assert z.nbytes == 8
+    single = array('f', [0.1])[0]
+    assert z[0] == complex(single, single)
+
+
+def test_frombuffer_shares_memory():
+    buf = array('d', [1.0, 2.0, 3.0, 4.0])
+    z = ComplexArray.frombuffer(buf)
+    assert z.tolist() == [1 + 2j, 3 + 4j]
+    buf[0] = 9.0
+    assert z[0] == 9 + 2j
+    with pytest.raises(ValueError):
+        ComplexArray.frombuffer(array('d', [1.0]))
+
+
+def test_slicing_and_assignment():
+    z = ComplexArray([1, 2j, 3, 4j])
+    view = z[1:3]
+    view[0] = 7
+    assert z[1] == 7
+    assert z[::2].tolist() == [1, 3]
+    z[2:4] = [5j, 6]
+    assert z.tolist() == [1, 7, 5j, 6]
+    with pytest.raises(ValueError):
+        z[0:2] = [1]
+
+
+def test_arithmetic():
+    a = ComplexArray([1 + 1j, 2 - 1j])
+    b = ComplexArray([1j, 2])
+    assert (a + b).tolist() == [1 + 2j, 4 - 1j]
+    assert (a - 1).tolist() == [1j, 1 - 1j]
+    assert (1 - a).tolist() == [-1j, -1 + 1j]
+    assert (a * b).tolist() == [-1 + 1j, 4 - 2j]
+    assert (2 * a).tolist() == [2 + 2j, 4 - 2j]
+    assert (a / b).tolist() == [1 - 1j, 1 - 0.5j]
+    assert (2j / ComplexArray([1j])).tolist() == [2]
+    assert (-a).tolist() == [-1 - 1j, -2 + 1j]
+    with pytest.raises(ValueError):
+        a + [1, 2, 3]
+
+
+def test_division_by_zero():
+    q = (ComplexArray([1 + 0j, 0j, -2j, 3 - 4j]) / 0).tolist()
+    # The zero imaginary part of 1+0j must not come back as a finite 0.
+    assert q[0].real == math.inf and math.isnan(q[0].imag)
+    assert math.isnan(q[1].real) and math.isnan(q[1].imag)
+    assert math.isnan(q[2].real) and q[2].imag == -math.inf
+    assert (q[3].real, q[3].imag) == (math.inf, -math.inf)
+    q = (ComplexArray([1 + 0j]) / ComplexArray([0j])).tolist()
+    assert q[0].real == math.inf and math.isnan(q[0].imag)
+
+
+def test_reductions_and_elementwise():
+    z = ComplexArray([3 + 4j, -1j])
+    assert z.conj().tolist() == [3 - 4j, 1j]
+    assert abs(z) == [5.0, 1.0]
+    assert z.angle(deg=True)[1] == -90.0
+    assert z.sum() == 3 + 3j
+    # conj(3+4j)*(1) + conj(-1j)*(1j) = 3 - 4j - 1.
+    assert z.vdot([1, 1j]) == 2 - 4j
+    assert ComplexArray([0j]).exp().tolist() == [1 + 0j]
+    assert (z == [3 + 4j, 1j]) == [True, False]
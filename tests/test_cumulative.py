@@ -0,0 +1,48 @@
+import pytest
+
+from arrpy.cumulative import cummax, cummin, cumprod, cumsum, diff, ediff1d
+
+M = [[1, 2, 3],
+     [4, 5, 6]]
+
+
+def test_scans_flatten_by_default():
+    assert cumsum(M) == [1, 3, 6, 10, 15, 21]
+    assert cumprod([1, 2, 3, 4]) == [1, 2, 6, 24]
+    assert cummin([3, 1, 2, 0]) == [3, 1, 1, 0]
+    assert cummax([3, 1, 4, 1, 5]) == [3, 3, 4, 4, 5]
+
+
+def test_scans_along_axis():
+    assert cumsum(M, axis=0) == [[1, 2, 3], [5, 7, 9]]
+    assert cumsum(M, axis=1) == [[1, 3, 6], [4, 9, 15]]
+    assert cumprod(M, axis=-1) == [[1, 2, 6], [4, 20, 120]]
+
+
+def test_diff_orders_and_axes():
+    assert diff([1, 4, 9, 16]) == [3, 5, 7]
+    assert diff([1, 4, 9, 16], n=2) == [2, 2]
+    assert diff([1, 4, 9], n=0) == [1, 4, 9]
+    assert diff(M, axis=0) == [[3, 3, 3]]
+    assert diff(M, axis=1) == [[1, 1], [1, 1]]
+    # Long inner axis takes the strided path.
+    wide = [list(range(10)), list(range(0, 20, 2))]
+    assert diff(wide, axis=0) == [list(range(10))]
+
+
+def test_diff_prepend_append():
+    assert diff([1, 3, 6], prepend=0) == [1, 2, 3]
+    assert diff([1, 3, 6], append=[10]) == [2, 3, 4]
+    assert diff(M, axis=0, prepend=0) == [[1, 2, 3], [3, 3, 3]]
+
+
+def test_diff_errors():
+    with pytest.raises(ValueError):
+        diff([1, 2], n=-1)
+    with pytest.raises(ValueError):
+        diff(5)
+
+
+def test_ediff1d():
+    assert ediff1d(M) == [1, 1, 1, 1, 1]
+    assert ediff1d([1, 2, 4], to_begin=0, to_end=[9, 9]) == [0, 1, 2, 9, 9]
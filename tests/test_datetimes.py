@@ -0,0 +1,77 @@
+import datetime
+
+import pytest
+
+from arrpy.datetimes import (NAT, DatetimeArray, TimedeltaArray,
+                             civil_from_days, datetime64, days_from_civil,
+                             timedelta64)
+
+
+def test_civil_round_trip():
+    assert days_from_civil(1970, 1, 1) == 0
+    assert days_from_civil(2000, 3, 1) == 11017
+    assert civil_from_days(11017) == (2000, 3, 1)
+    assert civil_from_days(-1) == (1969, 12, 31)
+
+
+def test_parse_strings_picks_finest_unit():
+    a = datetime64(['2024-03-01', '2024-03-01T12:30:05.25', 'NaT'])
+    assert a.unit == 'ms'
+    assert a.year == [2024, 2024, None]
+    assert a.hour == [0, 12, None]
+    assert a.isoformat() == ['2024-03-01T00:00:00.000',
+                             '2024-03-01T12:30:05.250', 'NaT']
+
+
+def test_datetime_objects_and_ticks():
+    a = DatetimeArray([datetime.date(1970, 1, 2)])
+    assert a.unit == 'D' and a.tolist() == [1]
+    b = DatetimeArray([0, 86400], unit='s')
+    assert b.day == [1, 2]
+    assert b.weekday == [3, 4]
+
+
+def test_arithmetic_and_nat():
+    a = datetime64(['2024-01-31', 'NaT'])
+    b = a + timedelta64(1, 'D')
+    assert b.isoformat() == ['2024-02-01', 'NaT']
+    d = b - a
+    assert isinstance(d, TimedeltaArray)
+    assert d.tolist() == [1, NAT]
+    assert (a < b) == [True, False]
+
+
+def test_floor_and_ceil():
+    a = DatetimeArray([90, -90], unit='m')
+    assert a.floor('h').tolist() == [60, -120]
+    assert a.ceil('h').tolist() == [120, -60]
+
+
+def test_out_of_range_fields_raise():
+    for text in ['2020-13-45', '2020-00-10', '2021-02-29', '2020-04-31',
+                 '2020-01-01T24:00', '2020-01-01T10:60', '2020-01-01T10:00:60']:
+        with pytest.raises(ValueError):
+            DatetimeArray([text])
+    assert DatetimeArray(['2020-02-29']).month == [2]
+
+
+def test_empty_list():
+    a = DatetimeArray([])
+    assert len(a) == 0 and a.unit == 'D'
+    assert DatetimeArray([], unit='s').unit == 's'
+
+
+def test_timedelta_division():
+    d = TimedeltaArray([10, -7, NAT], unit='s')
+    assert (d // 3).tolist() == [3, -3, NAT]
+    assert (d // 2.5).tolist() == [4, -3, NAT]
+    assert (d / 4).tolist() == [2, -1, NAT]
+    assert (d / 0.5).tolist() == [20, -14, NAT]
+    r = d / TimedeltaArray([5], unit='s')
+    assert r[:2] == [2.0, -1.4] and r[2] != r[2]
+    assert (d // TimedeltaArray([3], unit='s')) == [3, -3, None]
+    for bad in ([1, 2], 'x'):
+        with pytest.raises(TypeError):
+            d / bad
+        with pytest.raises(TypeError):
+            d // bad
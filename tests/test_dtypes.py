@@ -0,0 +1,81 @@
+import math
+import operator
+
+import pytest
+
+from arrpy.dtypes import (astype, binary_op, can_cast, dtype, float16, float32,
+                          float64, int8, int16, int32, int64, promote_types,
+                          result_type, uint8, uint64)
+
+
+def test_dtype_lookup_and_limits():
+    assert dtype('i4') is int32
+    assert dtype(float) is float64
+    assert dtype('half') is float16
+    assert (int8.min, int8.max) == (-128, 127)
+    assert uint8.max == 255
+    assert float16.max == 65504.0
+    with pytest.raises(TypeError):
+        dtype('complex256')
+
+
+def test_promotion_lattice():
+    assert promote_types('int8', 'uint8') is int16
+    assert promote_types('int16', 'uint8') is int16
+    assert promote_types('uint64', 'int64') is float64
+    assert promote_types('int8', 'float16') is float16
+    assert promote_types('int16', 'float16') is float32
+    assert promote_types('int32', 'float32') is float64
+    assert promote_types('bool', 'uint8') is uint8
+    assert result_type('int8', 'uint8', 'float32') is float32
+    with pytest.raises(ValueError):
+        result_type()
+
+
+def test_can_cast_rules():
+    assert can_cast('int8', 'int16')
+    assert not can_cast('int16', 'int8')
+    assert can_cast('int16', 'int8', 'same_kind')
+    assert not can_cast('float64', 'int64', 'same_kind')
+    assert can_cast('float64', 'int8', 'unsafe')
+    assert can_cast('int32', 'int32', 'no')
+    assert not can_cast('int32', 'int64', 'equiv')
+    with pytest.raises(ValueError):
+        can_cast('int8', 'int8', 'sometimes')
+
+
+def test_astype_wraps_integers():
+    assert astype([200, 300, -1], 'int8', from_dtype='int64') == [-56, 44, -1]
+    assert astype([-1, 256], 'uint8') == [255, 0]
+    assert astype(2 ** 64 + 5, 'uint8') == 5
+    assert astype([[1.9, -1.9]], 'int32') == [[1, -1]]
+    with pytest.raises(TypeError):
+        astype([1.5], 'int64', casting='safe')
+
+
+def test_astype_saturates():
+    assert astype([300, -300], 'int8', saturate=True) == [127, -128]
+    assert astype([math.nan, math.inf, -1e30], 'int16', saturate=True) == [
+        0, 32767, -32768]
+    with pytest.raises(ValueError):
+        astype([math.nan], 'int16')
+
+
+def test_astype_floats_round():
+    assert astype([0.1], 'float32') == [0.10000000149011612]
+    assert astype([0.1, 1e6], 'float16') == [0.0999755859375, math.inf]
+    assert astype([0, 2], 'bool') == [False, True]
+
+
+def test_binary_op_promotes_and_wraps():
+    out, res = binary_op(operator.add, [100, 100], 100, 'int8', 'int8')
+    assert res is int8 and out == [-56, -56]
+    out, res = binary_op(operator.mul, [1, 2], [0.5, 0.5], 'uint8', 'float32')
+    assert res is float32 and out == [0.5, 1.0]
+    out, res = binary_op(operator.add, 1, 2)
+    assert res is int64 and out == 3
+    out, res = binary_op(operator.add, [1], [2], 'uint64', 'int8')
+    assert res is float64 and out == [3.0]
+    assert uint64.max == 2 ** 64 - 1
+    with pytest.raises(ValueError):
+        binary_op(operator.add, [1, 2], [1, 2, 3])
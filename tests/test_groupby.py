@@ -0,0 +1,40 @@
+import math
+
+import pytest
+
+from arrpy import group_reduce
+
+
+def test_sum_mean_count_small_int_keys():
+    keys = [0, 2, 0, 2, 5]
+    values = [1, 2, 3, 4, 5]
+    assert group_reduce(keys, values) == ([0, 2, 5], [4, 6, 5])
+    assert group_reduce(keys, values, 'mean') == ([0, 2, 5], [2.0, 3.0, 5.0])
+    assert group_reduce(keys, op='count') == ([0, 2, 5], [2, 2, 1])
+
+
+def test_hashable_keys():
+    keys = ['b', 'a', 'b']
+    assert group_reduce(keys, [1, 2, 3], 'max') == (['a', 'b'], [2, 3])
+    assert group_reduce(keys, [1, 2, 3], 'first', sort=False) == (['b', 'a'], [1, 2])
+    assert group_reduce(keys, [1, 2, 3], 'argmin') == (['a', 'b'], [1, 0])
+
+
+def test_var_and_std():
+    keys, values = ['x', 'x', 'y'], [1.0, 3.0, 5.0]
+    _, var = group_reduce(keys, values, 'var')
+    assert var == [1.0, 0.0]
+    _, std = group_reduce(keys, values, 'std', ddof=1)
+    assert std[0] == math.sqrt(2.0) and math.isnan(std[1])
+
+
+def test_unsorted_small_int_keys_keep_first_appearance():
+    assert group_reduce([3, 1, 3], [1, 2, 3], sort=False) == ([3, 1], [4, 2])
+    assert group_reduce([3, 1, 3], [1, 2, 3]) == ([1, 3], [2, 4])
+
+
+def test_errors():
+    with pytest.raises(ValueError):
+        group_reduce([1], [1], 'median')
+    with pytest.raises(ValueError):
+        group_reduce([1, 2], [1])
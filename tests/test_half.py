@@ -0,0 +1,69 @@
+import math
+import struct
+from fractions import Fraction
+
+import pytest
+
+from arrpy.half import BFloat16Array, Float16Array
+
+
+def test_float16_rounding_and_overflow():
+    a = Float16Array([1.0, 0.1, 65504.0, 65520.0, -1e-8])
+    values = a.tolist()
+    assert values[0] == 1.0
+    assert values[1] == struct.unpack('<e', struct.pack('<e', 0.1))[0]
+    assert values[2] == 65504.0
+    assert values[3] == math.inf
+    assert a.nbytes == 10
+
+
+def test_bfloat16_keeps_range():
+    a = BFloat16Array([1.0, 3e38, 1.00390625])
+    assert a[0] == 1.0
+    assert a[1] == pytest.approx(3e38, rel=1e-2)
+    assert a[2] == 1.0  # halfway case rounds to even
+    assert math.isnan(BFloat16Array([math.nan])[0])
+
+
+def test_frombuffer_shares_memory():
+    buf = bytearray(struct.pack('<2e', 1.5, -2.0))
+    a = Float16Array.frombuffer(buf)
+    assert a.tolist() == [1.5, -2.0]
+    a[0] = 3.0
+    assert struct.unpack('<2e', buf) == (3.0, -2.0)
+
+
+def test_arithmetic_and_reductions():
+    a = Float16Array([1.0, 2.0, 4.0])
+    assert (a + 1).tolist() == [2.0, 3.0, 5.0]
+    assert (a * [2, 2, 2]).tolist() == [2.0, 4.0, 8.0]
+    assert (a / 0).tolist() == [math.inf] * 3
+    assert a.sum() == 7.0 and a.mean() == 7.0 / 3
+    assert a.dot([1, 1, 1]) == 7.0
+    assert (-a).tolist() == [-1.0, -2.0, -4.0]
+    assert a[1:].tolist() == [2.0, 4.0]
+
+
+def test_reflected_operators():
+    a = Float16Array([1.0, 2.0])
+    assert (1 - a).tolist() == [0.0, -1.0]
+    assert (1 / a).tolist() == [1.0, 0.5]
+    assert ([3, 3] - a).tolist() == [2.0, 1.0]
+    assert (2 + a).tolist() == [3.0, 4.0]
+    assert (2 * BFloat16Array([1.5])).tolist() == [3.0]
+    assert (1.0 / Float16Array([0.0])).tolist() == [math.inf]
+
+
+@pytest.mark.parametrize('cls', [Float16Array, BFloat16Array])
+def test_fraction_and_int_list_operands(cls):
+    a = cls([1.0, 2.0])
+    assert (a + Fraction(1, 2)).tolist() == [1.5, 2.5]
+    assert (Fraction(1, 2) + a).tolist() == [1.5, 2.5]
+    assert (a - Fraction(1, 2)).tolist() == [0.5, 1.5]
+    assert (a * Fraction(3, 2)).tolist() == [1.5, 3.0]
+    assert (a + [1, 2]).tolist() == [2.0, 4.0]
+    assert (a - [1, 1]).tolist() == [0.0, 1.0]
+    assert (a * [3, 4]).tolist() == [3.0, 8.0]
+    assert ([3, 4] - a).tolist() == [2.0, 2.0]
+    with pytest.raises(TypeError):
+        a + [1j, 2j]
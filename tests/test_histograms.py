@@ -0,0 +1,72 @@
+import math
+
+import pytest
+
+from arrpy.histograms import (digitize, histogram, histogram2d, histogramdd,
+                              searchsorted)
+
+
+def test_histogram_uniform_bins():
+    hist, edges = histogram([1, 2, 2, 3, 3, 3], bins=2)
+    assert edges == [1.0, 2.0, 3.0]
+    # The last bin is closed, so 3 lands in it.
+    assert hist == [1, 5]
+    hist, _ = histogram([0, 1, 2, 3, 4, 10], bins=4, range=(0, 4))
+    assert hist == [1, 1, 1, 2]
+
+
+def test_histogram_edges_weights_density():
+    hist, edges = histogram([0.5, 1.5, 1.5, 3.0], bins=[0, 1, 2, 4])
+    assert edges == [0, 1, 2, 4] and hist == [1, 2, 1]
+    hist, _ = histogram([0.5, 1.5, 3.0], bins=[0, 1, 2, 4], weights=[2, 3, 5])
+    assert hist == [2, 3, 5]
+    dens, _ = histogram([0.5, 1.5, 1.5, 3.0], bins=[0, 1, 2, 4], density=True)
+    assert dens == [0.25, 0.5, 0.125]
+    assert math.fsum(d * w for d, w in zip(dens, [1, 1, 2])) == 1.0
+    with pytest.raises(ValueError):
+        histogram([1, 2], weights=[1])
+
+
+def test_histogram_uniform_bins_match_edge_comparisons():
+    # 0.3 sits exactly on a computed edge of [0, 1] split ten ways.
+    values = [i / 10 for i in range(11)]
+    hist, edges = histogram(values, bins=10, range=(0, 1))
+    expected = [0] * 10
+    for v in values:
+        for i in range(10):
+            if edges[i] <= v < edges[i + 1] or (i == 9 and v == edges[10]):
+                expected[i] += 1
+                break
+    assert hist == expected
+
+
+def test_histogram2d_and_dd():
+    H, xe, ye = histogram2d([0, 0, 1, 1], [0, 1, 1, 1], bins=2)
+    assert xe == [0.0, 0.5, 1.0] and ye == [0.0, 0.5, 1.0]
+    assert H == [[1, 1], [0, 2]]
+    H, edges = histogramdd([(0, 0, 0), (1, 1, 1)], bins=[1, 2, 1])
+    assert H == [[[1], [1]]]
+    assert len(edges) == 3
+    with pytest.raises(ValueError):
+        histogram2d([1, 2], [1])
+    with pytest.raises(ValueError):
+        histogramdd([(0, 0)], bins=[2, 2, 2])
+
+
+def test_searchsorted():
+    a = [1, 2, 2, 3]
+    assert searchsorted(a, 2) == 1
+    assert searchsorted(a, 2, side='right') == 3
+    assert searchsorted(a, [[0, 4]]) == [[0, 4]]
+    assert searchsorted([3, 1, 2], 2, sorter=[1, 2, 0]) == 1
+    with pytest.raises(ValueError):
+        searchsorted(a, 1, side='middle')
+
+
+def test_digitize():
+    bins = [0, 1, 2]
+    assert digitize([-1, 0, 0.5, 1, 2, 3], bins) == [0, 1, 1, 2, 3, 3]
+    assert digitize([0, 1, 2], bins, right=True) == [0, 1, 2]
+    assert digitize([1.5, 3, 0], [3, 2, 1]) == [2, 0, 3]
+    with pytest.raises(ValueError):
+        digitize([1], [0, 2, 1])
@@ -0,0 +1,94 @@
+import math
+
+import pytest
+
+from arrpy.interpolate import (Akima1DInterpolator, CubicSpline,
+                               RegularGridInterpolator, interp)
+
+XP = [0.0, 1.0, 3.0]
+FP = [0.0, 10.0, 30.0]
+
+
+def test_interp_sorted_and_unsorted_agree():
+    xs = [-1.0, 0.0, 0.5, 1.0, 2.0, 3.0, 4.0]
+    want = [0.0, 0.0, 5.0, 10.0, 20.0, 30.0, 30.0]
+    assert interp(xs, XP, FP) == want
+    shuffled = [2.0, -1.0, 4.0, 0.5, 3.0, 0.0, 1.0]
+    assert interp(shuffled, XP, FP) == [20.0, 0.0, 30.0, 5.0, 30.0, 0.0, 10.0]
+
+
+def test_interp_left_right_nan_and_shapes():
+    assert interp([-1.0, 5.0], XP, FP, left=-9, right=9) == [-9, 9]
+    assert interp([3.0, 5.0, 2.0], XP, FP, right=9) == [30.0, 9, 20.0]
+    out = interp([1.0, math.nan], XP, FP)
+    assert out[0] == 10.0 and math.isnan(out[1])
+    assert interp(0.5, XP, FP) == 5.0
+    assert interp([[0.5], [2.0]], XP, FP) == [[5.0], [20.0]]
+    assert interp([0.0, 1.0, 2.0], [1.0], [7.0], left=0, right=9) == [0, 7.0, 9]
+    with pytest.raises(ValueError):
+        interp([1.0], [0.0, 1.0], [1.0])
+
+
+def test_interp_nan_queries_give_nan():
+    assert math.isnan(interp(math.nan, XP, FP))
+    out = interp([math.nan], XP, FP)
+    assert len(out) == 1 and math.isnan(out[0])
+    s = CubicSpline([0.0, 1.0, 2.0, 3.0], [0.0, 1.0, 4.0, 9.0])
+    assert math.isnan(s(math.nan))
+    out = s([math.nan])
+    assert len(out) == 1 and math.isnan(out[0])
+
+
+def test_cubic_spline_reproduces_cubics():
+    def f(v):
+        return v ** 3 - 2 * v + 1
+    x = [0.0, 0.5, 1.5, 2.0, 3.0]
+    s = CubicSpline(x, [f(v) for v in x])
+    xs = [-0.5, 0.25, 1.0, 2.5, 3.5]
+    assert all(math.isclose(a, f(v), abs_tol=1e-12) for a, v in zip(s(xs), xs))
+    assert math.isclose(s(1.0, nu=1), 1.0)
+    assert math.isclose(s.derivative(2)(1.0), 6.0)
+    assert math.isclose(s(0.7, nu=3), 6.0)
+    # Three knots under not-a-knot give the interpolating parabola.
+    p = CubicSpline([0.0, 1.0, 2.0], [0.0, 1.0, 4.0])
+    assert math.isclose(p(1.5), 2.25)
+
+
+def test_natural_spline():
+    s = CubicSpline([0.0, 1.0, 2.0, 3.0], [0.0, 1.0, 0.0, 1.0], bc_type='natural')
+    assert s([0.0, 1.0, 2.0, 3.0]) == pytest.approx([0.0, 1.0, 0.0, 1.0])
+    assert s([0.0, 3.0], nu=2) == pytest.approx([0.0, 0.0], abs=1e-12)
+    with pytest.raises(ValueError):
+        CubicSpline([0.0, 1.0], [0.0, 1.0], bc_type='clamped')
+    with pytest.raises(ValueError):
+        CubicSpline([0.0, 0.0, 1.0], [0.0, 1.0, 2.0])
+
+
+def test_akima():
+    a = Akima1DInterpolator([0.0, 1.0, 2.0, 3.0, 4.0], [0.0, 2.0, 4.0, 6.0, 8.0])
+    assert a([0.5, 3.25]) == pytest.approx([1.0, 6.5])
+    # A step stays flat away from the jump instead of overshooting.
+    step = Akima1DInterpolator([0.0, 1.0, 2.0, 3.0, 4.0, 5.0],
+                               [0.0, 0.0, 0.0, 1.0, 1.0, 1.0])
+    assert step([0.5, 1.5, 3.5, 4.5]) == pytest.approx([0.0, 0.0, 1.0, 1.0])
+    with pytest.raises(ValueError):
+        step(1.0, nu=4)
+
+
+def test_regular_grid_interpolator():
+    xs, ys = [0.0, 1.0, 2.0], [0.0, 2.0]
+    values = [[x + 3 * y for y in ys] for x in xs]
+    lin = RegularGridInterpolator([xs, ys], values)
+    assert lin([[0.5, 1.0], [2.0, 2.0]]) == pytest.approx([3.5, 8.0])
+    assert lin([1.5, 0.5]) == pytest.approx(3.0)
+    near = RegularGridInterpolator([xs, ys], values, method='nearest')
+    assert near([[0.4, 1.2], [1.6, 0.2]]) == [6.0, 2.0]
+    with pytest.raises(ValueError):
+        lin([3.0, 0.0])
+    filled = RegularGridInterpolator([xs, ys], values, bounds_error=False)
+    assert math.isnan(filled([3.0, 0.0]))
+    extrap = RegularGridInterpolator([xs, ys], values, bounds_error=False,
+                                     fill_value=None)
+    assert extrap([3.0, 0.0]) == pytest.approx(3.0)
+    with pytest.raises(ValueError):
+        RegularGridInterpolator([xs, ys], [[1.0, 2.0]])
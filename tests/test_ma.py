@@ -0,0 +1,90 @@
+import math
+
+import pytest
+
+from arrpy.ma import (MaskedArray, masked_invalid, nancount, nanmax, nanmean,
+                      nanmin, nanprod, nanstd, nansum, nanvar)
+
+NAN = math.nan
+
+
+def test_mask_and_bitmap_layout():
+    m = MaskedArray([1, None, 3, 4], mask=[False, False, True, False])
+    assert m.mask == [False, True, True, False]
+    assert m.validity == bytes([0b1001])
+    assert m.count() == 2
+    assert m.tolist() == [1, None, None, 4]
+    assert m.filled(-1) == [1, -1, -1, 4]
+    assert m.compressed() == [1, 4]
+    with pytest.raises(ValueError):
+        MaskedArray([1, 2], mask=[True])
+
+
+def test_from_bitmap_matches_arrow():
+    # Nine values need two validity bytes; bits beyond n are ignored.
+    m = MaskedArray.from_bitmap(list(range(9)), bytes([0b10101010, 0xFF]))
+    assert m.compressed() == [1, 3, 5, 7, 8]
+    assert m.validity == bytes([0b10101010, 0b1])
+    with pytest.raises(ValueError):
+        MaskedArray.from_bitmap(list(range(9)), b'\xff')
+
+
+def test_indexing():
+    m = MaskedArray([1, None, 3])
+    assert m[0] == 1 and m[1] is None and m[-1] == 3
+    assert m[1:].tolist() == [None, 3]
+    with pytest.raises(IndexError):
+        m[3]
+
+
+def test_arithmetic_combines_masks():
+    a = MaskedArray([1, None, 3, 4])
+    b = MaskedArray([10, 20, None, 40])
+    assert (a + b).tolist() == [11, None, None, 44]
+    assert (a * 2).tolist() == [2, None, 6, 8]
+    assert (10 - a).tolist() == [9, None, 7, 6]
+    assert (-a).tolist() == [-1, None, -3, -4]
+    assert (a == [1, 0, 3, 5]) == [True, None, True, False]
+    with pytest.raises(ValueError):
+        a + [1, 2]
+
+
+def test_division_by_zero_is_masked():
+    a = MaskedArray([1.0, 2.0, 0.0])
+    assert (a / [2, 0, 1]).tolist() == [0.5, None, 0.0]
+    assert (1 / a).tolist() == [1.0, 0.5, None]
+
+
+def test_masked_reductions():
+    m = MaskedArray([1.0, None, 3.0, 5.0])
+    assert m.sum() == 9.0
+    assert m.mean() == 3.0
+    assert m.var() == 8 / 3
+    assert m.var(ddof=1) == 4.0
+    assert m.std(ddof=1) == 2.0
+    assert (m.min(), m.max()) == (1.0, 5.0)
+    empty = MaskedArray([None])
+    assert empty.mean() is None and empty.min() is None and empty.var() is None
+
+
+def test_masked_invalid():
+    m = masked_invalid([1.0, NAN, math.inf, 2.0])
+    assert m.tolist() == [1.0, None, None, 2.0]
+
+
+def test_nan_reductions():
+    a = [[1.0, NAN, 3.0],
+         [NAN, NAN, 6.0]]
+    assert nansum(a) == 10.0
+    assert nanprod(a) == 18.0
+    assert nancount(a) == 3
+    assert nansum(a, axis=0) == [1.0, 0.0, 9.0]
+    assert nancount(a, axis=1) == [2, 1]
+    assert nanmean(a, axis=1) == [2.0, 6.0]
+    assert nanmin(a, axis=1) == [1.0, 6.0]
+    assert nanmax(a) == 6.0
+    assert nanvar([1.0, NAN, 3.0]) == 1.0
+    assert nanstd([1.0, NAN, 3.0], ddof=1) == math.sqrt(2.0)
+    col = nanmean(a, axis=0)
+    assert col[0] == 1.0 and math.isnan(col[1]) and col[2] == 4.5
+    assert math.isnan(nanmin([NAN, NAN]))
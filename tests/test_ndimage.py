@@ -0,0 +1,164 @@
+import random
+
+import pytest
+
+from arrpy.ndimage import (binary_dilation, binary_erosion, convolve1d,
+                           correlate1d, gaussian_filter, gaussian_filter1d,
+                           generate_binary_structure, grey_dilation,
+                           grey_erosion, map_coordinates, median_filter,
+                           uniform_filter, uniform_filter1d, zoom)
+
+
+@pytest.mark.parametrize('mode, expected', [
+    ('reflect', [4.0, 6.0, 8.0]),      # 1 | 1 2 3 | 3
+    ('mirror', [5.0, 6.0, 7.0]),       # 2 | 1 2 3 | 2
+    ('nearest', [4.0, 6.0, 8.0]),      # 1 | 1 2 3 | 3
+    ('wrap', [6.0, 6.0, 6.0]),         # 3 | 1 2 3 | 1
+    ('constant', [3.0, 6.0, 5.0]),     # 0 | 1 2 3 | 0
+])
+def test_correlate1d_modes(mode, expected):
+    assert correlate1d([1, 2, 3], [1.0, 1.0, 1.0], mode=mode) == expected
+
+
+def test_correlate_and_convolve_orientation():
+    assert correlate1d([1, 2, 3], [0, 0, 1]) == [2, 3, 3]
+    assert convolve1d([1, 2, 3], [0, 0, 1]) == [1, 1, 2]
+    # Even-length kernels: correlate looks back, convolve looks ahead.
+    assert correlate1d([1, 2, 3, 4], [1, 1]) == [2, 3, 5, 7]
+    assert convolve1d([1, 2, 3, 4], [1, 1]) == [3, 5, 7, 8]
+    assert correlate1d([[1, 2], [3, 4]], [1, 1, 1], axis=0, mode='constant',
+                       cval=0) == [[4, 6], [4, 6]]
+    with pytest.raises(ValueError):
+        correlate1d([1, 2], [])
+    with pytest.raises(ValueError):
+        correlate1d([1, 2], [1], mode='edge')
+
+
+def test_gaussian_filters():
+    flat = [[5.0] * 4 for _ in range(3)]
+    for row in gaussian_filter(flat, 1.0):
+        assert row == pytest.approx([5.0] * 4)
+    impulse = [0.0] * 9
+    impulse[4] = 1.0
+    out = gaussian_filter1d(impulse, 1.0)
+    assert sum(out) == pytest.approx(1.0)
+    assert out == pytest.approx(out[::-1])
+    assert max(out) == out[4]
+    assert gaussian_filter([[1.0, 2.0]], (0, 0)) == [[1.0, 2.0]]
+    with pytest.raises(ValueError):
+        gaussian_filter1d(impulse, 0)
+
+
+def test_uniform_filters():
+    assert uniform_filter1d([1, 2, 3, 4, 5], 3) == pytest.approx(
+        [4 / 3, 2.0, 3.0, 4.0, 14 / 3])
+    grid = [[1, 2, 3],
+            [4, 5, 6],
+            [7, 8, 9]]
+    assert uniform_filter(grid, 3)[1][1] == pytest.approx(5.0)
+    assert uniform_filter(grid, (1, 3), mode='constant')[0] == pytest.approx(
+        [1.0, 2.0, 5 / 3])
+    with pytest.raises(ValueError):
+        uniform_filter1d([1, 2], 0)
+
+
+def test_median_filter():
+    assert median_filter([1, 5, 2, 8, 3], 3) == [1, 2, 5, 3, 3]
+    grid = [[1, 9, 1],
+            [9, 1, 9],
+            [1, 9, 1]]
+    # Zero padding adds three zeros to each edge window.
+    assert median_filter(grid, 3, mode='constant') == [[0, 1, 0],
+                                                       [1, 1, 1],
+                                                       [0, 1, 0]]
+    assert median_filter(grid, 3, workers=2) == median_filter(grid, 3)
+    # An even window takes the upper middle value.
+    assert median_filter([4, 1, 3, 2], 2) == [4, 4, 3, 3]
+
+
+def _brute_median(image, size, cval):
+    rows, cols = len(image), len(image[0])
+    r = size // 2
+
+    def at(i, j):
+        return image[i][j] if 0 <= i < rows and 0 <= j < cols else cval
+    return [[sorted(at(i + a, j + b) for a in range(-r, size - r)
+                    for b in range(-r, size - r))[size * size // 2]
+             for j in range(cols)] for i in range(rows)]
+
+
+def test_median_filter_histogram_path():
+    rng = random.Random(2)
+    image = [[rng.randrange(256) for _ in range(17)] for _ in range(9)]
+    for size in (5, 6):
+        want = _brute_median(image, size, 0)
+        assert median_filter(image, size, mode='constant', cval=0) == want
+        # A float cval takes the sorted-window path; the answer is the same.
+        assert median_filter(image, size, mode='constant', cval=0.0) == want
+    shifted = [[v - 1000 for v in row] for row in image]
+    assert median_filter(shifted, 5) == [
+        [v - 1000 for v in row] for row in median_filter(image, 5)]
+    assert median_filter(shifted, 5, workers=3) == median_filter(shifted, 5)
+
+
+def _brute_extreme(lane, w, before, func):
+    n = len(lane)
+    ext = lane[before - 1::-1] if before else []
+    p = ext + lane + lane[::-1]
+    return [func(p[i:i + w]) for i in range(n)]
+
+
+def test_grey_morphology():
+    x = [3, 1, 4, 1, 5, 9, 2]
+    assert grey_erosion(x, 3) == [1, 1, 1, 1, 1, 2, 2]
+    assert grey_dilation(x, 3) == [3, 4, 4, 5, 9, 9, 9]
+    lane = [(i * 7919) % 97 for i in range(60)]
+    # Windows past the shifted-slice limit take the van Herk path.
+    assert grey_erosion(lane, 21) == _brute_extreme(lane, 21, 10, min)
+    assert grey_dilation(lane, 20) == _brute_extreme(lane, 20, 9, max)
+    grid = [[1, 2], [3, 4]]
+    assert grey_erosion(grid, (2, 1)) == [[1, 2], [1, 2]]
+
+
+def test_binary_morphology():
+    assert generate_binary_structure(2, 1) == [[False, True, False],
+                                               [True, True, True],
+                                               [False, True, False]]
+    assert generate_binary_structure(1, 1) == [True, True, True]
+    dot = [[0] * 5 for _ in range(5)]
+    dot[2][2] = 1
+    cross = binary_dilation(dot)
+    assert [[int(v) for v in row] for row in cross] == [
+        [0, 0, 0, 0, 0],
+        [0, 0, 1, 0, 0],
+        [0, 1, 1, 1, 0],
+        [0, 0, 1, 0, 0],
+        [0, 0, 0, 0, 0]]
+    assert binary_erosion(cross) == [[(i, j) == (2, 2) for j in range(5)]
+                                     for i in range(5)]
+    box = generate_binary_structure(2, 2)
+    assert all(all(row) for row in binary_dilation(dot, box, iterations=0))
+    full = [[1, 1], [1, 1]]
+    assert binary_erosion(full) == [[False, False], [False, False]]
+    assert binary_erosion(full, border_value=1) == [[True, True], [True, True]]
+
+
+def test_zoom():
+    assert zoom([0.0, 2.0], 2) == pytest.approx([0.0, 2 / 3, 4 / 3, 2.0])
+    assert zoom([0, 2], 2, order=0) == [0, 0, 2, 2]
+    assert zoom([[1.0, 3.0]], (1, 1.5))[0] == pytest.approx([1.0, 2.0, 3.0])
+    with pytest.raises(ValueError):
+        zoom([1.0], 0.1)
+    with pytest.raises(ValueError):
+        zoom([1.0, 2.0], 2, order=3)
+
+
+def test_map_coordinates():
+    img = [[0.0, 1.0],
+           [2.0, 3.0]]
+    assert map_coordinates(img, [[0.5, 1.0], [0.5, 0.0]]) == [1.5, 2.0]
+    assert map_coordinates(img, [[2.0], [0.0]], cval=-1.0) == [-1.0]
+    assert map_coordinates(img, [[0.6], [0.4]], order=0) == [2.0]
+    assert map_coordinates(img, [[-1.0], [0.0]], mode='nearest') == [0.0]
+    with pytest.raises(ValueError):
+        map_coordinates(img, [[0.0]])
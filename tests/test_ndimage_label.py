@@ -0,0 +1,100 @@
+import math
+import random
+
+import pytest
+
+from arrpy.ndimage import (find_objects, generate_binary_structure, label,
+                           mean_labels, sum_labels)
+
+IMAGE = [[1, 1, 0, 0, 1],
+         [0, 1, 0, 1, 1],
+         [1, 0, 0, 0, 0],
+         [1, 1, 0, 1, 0]]
+
+
+def _flood(image, diagonal):
+    # Reference labelling by breadth-first search in row-major order.
+    rows, cols = len(image), len(image[0])
+    out = [[0] * cols for _ in range(rows)]
+    steps = [(dr, dc) for dr in (-1, 0, 1) for dc in (-1, 0, 1)
+             if (dr or dc) and (diagonal or not (dr and dc))]
+    count = 0
+    for r in range(rows):
+        for c in range(cols):
+            if image[r][c] and not out[r][c]:
+                count += 1
+                out[r][c] = count
+                queue = [(r, c)]
+                for i, j in queue:
+                    for dr, dc in steps:
+                        a, b = i + dr, j + dc
+                        if (0 <= a < rows and 0 <= b < cols and image[a][b]
+                                and not out[a][b]):
+                            out[a][b] = count
+                            queue.append((a, b))
+    return out, count
+
+
+def test_label_cross_and_box():
+    labels, n = label(IMAGE)
+    assert n == 4
+    assert labels == [[1, 1, 0, 0, 2],
+                      [0, 1, 0, 2, 2],
+                      [3, 0, 0, 0, 0],
+                      [3, 3, 0, 4, 0]]
+    labels, n = label(IMAGE, generate_binary_structure(2, 2))
+    assert n == 3
+    assert labels[2][0] == 1 and labels[3][3] == 3
+
+
+def test_label_merges_late_joins():
+    # The two arms of the U only meet on the last row.
+    u = [[1, 0, 1],
+         [1, 0, 1],
+         [1, 1, 1]]
+    labels, n = label(u)
+    assert n == 1 and labels[0] == [1, 0, 1]
+
+
+def test_label_matches_flood_fill():
+    rng = random.Random(11)
+    image = [[int(rng.random() < 0.45) for _ in range(23)] for _ in range(17)]
+    for diagonal in (False, True):
+        structure = generate_binary_structure(2, 2 if diagonal else 1)
+        want = _flood(image, diagonal)
+        assert label(image, structure) == want
+        assert label(image, structure, workers=4) == want
+
+
+def test_label_1d_3d_and_errors():
+    assert label([0, 1, 1, 0, 1]) == ([0, 1, 1, 0, 2], 2)
+    cube = [[[1, 0], [0, 0]], [[1, 0], [0, 1]]]
+    labels, n = label(cube)
+    assert n == 2 and labels[1][0][0] == 1 and labels[1][1][1] == 2
+    with pytest.raises(ValueError):
+        label(IMAGE, [[1, 1], [1, 1]])
+    with pytest.raises(ValueError):
+        label(IMAGE, [[1, 1, 0], [0, 1, 0], [0, 0, 0]])
+
+
+def test_find_objects():
+    labels, _ = label(IMAGE)
+    boxes = find_objects(labels)
+    assert boxes == [(slice(0, 2), slice(0, 2)), (slice(0, 2), slice(3, 5)),
+                     (slice(2, 4), slice(0, 2)), (slice(3, 4), slice(3, 4))]
+    assert find_objects([0, 2, 2], max_label=3) == [None, (slice(1, 3),), None]
+    assert find_objects([3, 0, 1], max_label=1) == [(slice(2, 3),)]
+
+
+def test_sum_and_mean_labels():
+    values = [[1, 2, 3],
+              [4, 5, 6]]
+    labels = [[1, 1, 0],
+              [2, 0, 2]]
+    assert sum_labels(values) == 21
+    assert sum_labels(values, labels) == 13
+    assert sum_labels(values, labels, 2) == 10
+    assert sum_labels(values, labels, [0, 1, 3]) == [8, 3, 0]
+    assert mean_labels(values, labels, [1, 2]) == [1.5, 5.0]
+    missing = mean_labels(values, labels, [3])
+    assert math.isnan(missing[0])
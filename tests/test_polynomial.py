@@ -0,0 +1,69 @@
+import math
+
+import pytest
+
+from arrpy.polynomial import Polynomial, polyfit, polymul, polyval, roots
+
+
+def test_polyval_shapes():
+    assert polyval([1, 2, 3], 2) == 11
+    assert polyval([1, 2, 3], [0, 1, -1]) == [3, 6, 2]
+    assert polyval([2.0, 0.0], [[1.0, 2.0]]) == [[2.0, 4.0]]
+    assert polyval([], [1.0, 2.0]) == [0.0, 0.0]
+
+
+def test_polyval_high_degree_falls_back():
+    # (x + 1) ** 40 has binomial coefficients; degree 40 exceeds the unroll.
+    p = [math.comb(40, k) for k in range(41)]
+    assert polyval(p, [1, 2]) == [2 ** 40, 3 ** 40]
+
+
+def test_polyfit_exact_and_weighted():
+    x = [0.0, 1.0, 2.0, 3.0]
+    y = [2 * v * v - v + 3 for v in x]
+    assert polyfit(x, y, 2) == pytest.approx([2.0, -1.0, 3.0])
+    # A zero weight removes the outlier from the fit.
+    fit = polyfit(x + [4.0], [1.0, 3.0, 5.0, 7.0, 100.0], 1,
+                  w=[1, 1, 1, 1, 0])
+    assert fit == pytest.approx([2.0, 1.0])
+    # Least squares through (0, 0), (1, 1), (2, 1): slope 1/2, intercept 1/6.
+    assert polyfit([0, 1, 2], [0, 1, 1], 1) == pytest.approx([0.5, 1 / 6])
+    with pytest.raises(ValueError):
+        polyfit([1.0, 2.0], [1.0, 2.0], 2)
+    with pytest.raises(ValueError):
+        polyfit([1.0, 1.0, 1.0], [1.0, 2.0, 3.0], 1)
+
+
+def test_roots_real_and_complex():
+    assert sorted(roots([1, -3, 2])) == pytest.approx([1.0, 2.0])
+    assert sorted(roots([1, -6, 11, -6])) == pytest.approx([1.0, 2.0, 3.0])
+    r = sorted(roots([1, 0, 1]), key=lambda z: z.imag)
+    assert r == pytest.approx([-1j, 1j])
+    assert sorted(roots([0, 1, -1, 0])) == pytest.approx([0.0, 1.0])
+    assert roots([5]) == []
+    with pytest.raises(TypeError):
+        roots([1, 1j])
+
+
+def test_polymul():
+    assert polymul([1, 2], [3, 4]) == [3, 10, 8]
+    assert polymul([1, 1], [1, -1]) == [1, 0, -1]
+
+
+def test_polynomial_class():
+    p = Polynomial([1, 2, 3])  # 1 + 2x + 3x^2
+    assert p.degree() == 2
+    assert p(2) == 17
+    assert (p + 1).coef == [2, 2, 3]
+    assert (p - Polynomial([1, 2])).coef == [0, 0, 3]
+    assert (1 - p).coef == [0, -2, -3]
+    assert (p * Polynomial([0, 1])).coef == [0, 1, 2, 3]
+    assert (2 * p).coef == [2, 4, 6]
+    assert p.deriv().coef == [2, 6]
+    assert p.deriv(3).coef == [0]
+    assert p.integ(k=5).coef == [5, 1.0, 1.0, 1.0]
+    assert sorted(Polynomial([-4, 0, 1]).roots()) == pytest.approx([-2.0, 2.0])
+    fit = Polynomial.fit([0, 1, 2], [1, 3, 5], 1)
+    assert fit.coef == pytest.approx([1.0, 2.0])
+    with pytest.raises(ValueError):
+        Polynomial([])
@@ -0,0 +1,100 @@
+import math
+
+import pytest
+
+from arrpy.random import AliasTable, Generator, default_rng
+
+
+def test_seeded_streams_repeat():
+    a = default_rng(7).normal(size=5)
+    b = default_rng(7).normal(size=5)
+    assert a == b
+    rng = Generator(3)
+    assert default_rng(rng) is rng
+
+
+def test_size_shapes():
+    rng = default_rng(0)
+    assert isinstance(rng.random(), float)
+    assert len(rng.random(4)) == 4
+    grid = rng.uniform(2.0, 3.0, size=(2, 3))
+    assert [len(row) for row in grid] == [3, 3]
+    assert all(2.0 <= v < 3.0 for row in grid for v in row)
+
+
+def test_integers_bounds():
+    rng = default_rng(1)
+    draws = rng.integers(-2, 3, size=500)
+    assert set(draws) == {-2, -1, 0, 1, 2}
+    assert all(0 <= v < 4 for v in rng.integers(4, size=50))
+    with pytest.raises(ValueError):
+        rng.integers(5, 5)
+
+
+def test_moments_are_plausible():
+    rng = default_rng(2)
+    n = 20000
+    normal = rng.normal(1.0, 2.0, size=n)
+    assert abs(math.fsum(normal) / n - 1.0) < 0.1
+    gamma = rng.gamma(3.0, 2.0, size=n)
+    assert abs(math.fsum(gamma) / n - 6.0) < 0.2
+    binom = rng.binomial(100, 0.3, size=n)
+    assert all(0 <= v <= 100 for v in binom)
+    assert abs(sum(binom) / n - 30.0) < 0.5
+    pois = rng.poisson(4.0, size=n)
+    assert abs(sum(pois) / n - 4.0) < 0.1
+
+
+def test_multinomial_sums_to_n():
+    rng = default_rng(4)
+    for row in rng.multinomial(10, [0.2, 0.3, 0.5], size=20):
+        assert len(row) == 3
+        assert sum(row) == 10
+
+
+def test_choice_without_replacement_is_unique():
+    rng = default_rng(5)
+    picks = rng.choice(10, size=10, replace=False)
+    assert sorted(picks) == list(range(10))
+    weighted = rng.choice('abcd', size=3, replace=False, p=[1, 1, 0, 1])
+    assert 'c' not in weighted and len(set(weighted)) == 3
+    with pytest.raises(ValueError):
+        rng.choice(3, size=4, replace=False)
+    with pytest.raises(ValueError):
+        rng.choice(3, p=[0.5, 0.5])
+
+
+def test_alias_table_frequencies():
+    table = AliasTable([1, 0, 3])
+    assert len(table) == 3
+    rng = default_rng(6)
+    draws = rng.choice(['x', 'y', 'z'], size=8000, p=table)
+    assert draws.count('y') == 0
+    assert abs(draws.count('z') / 8000 - 0.75) < 0.03
+    with pytest.raises(ValueError):
+        AliasTable([0, 0])
+    with pytest.raises(ValueError):
+        AliasTable([1, -1])
+
+
+def test_permutation_and_shuffle():
+    rng = default_rng(8)
+    assert sorted(rng.permutation(6)) == list(range(6))
+    data = [3, 1, 4, 1, 5]
+    out = rng.permutation(data)
+    assert sorted(out) == sorted(data) and data == [3, 1, 4, 1, 5]
+    rng.shuffle(data)
+    assert sorted(data) == [1, 1, 3, 4, 5]
+
+
+def test_weighted_sample_without_replacement_tiny_weights():
+    # u ** (1 / w) underflows to 0 for tiny w; the log-space key does not.
+    rng = default_rng(9)
+    counts = [0] * 4
+    for _ in range(2000):
+        counts[rng.choice(4, size=1, replace=False, p=[1e-300] * 4)[0]] += 1
+    assert min(counts) > 400
+    # Relative weights still matter at that scale.
+    heavy = sum(rng.choice(2, size=1, replace=False, p=[1e-300, 3e-300])[0]
+                for _ in range(2000))
+    assert abs(heavy / 2000 - 0.75) < 0.04
@@ -0,0 +1,71 @@
+import struct
+
+import pytest
+
+from arrpy.records import RecordArray, StructDtype
+
+POINT = [('x', 'f8'), ('y', 'f8')]
+
+
+def test_layout_packed_and_aligned():
+    packed = StructDtype([('a', 'u1'), ('b', 'i4'), ('c', 'u2')])
+    assert packed.itemsize == 7
+    assert packed.fields['b'][1] == 1
+    aligned = StructDtype([('a', 'u1'), ('b', 'i4'), ('c', 'u2')], align=True)
+    # Like the C struct {uint8_t a; int32_t b; uint16_t c;}.
+    assert aligned.fields['b'][1] == 4
+    assert aligned.fields['c'][1] == 8
+    assert aligned.itemsize == 12
+    with pytest.raises(ValueError):
+        StructDtype([('a', 'u1'), ('a', 'u2')])
+    with pytest.raises(ValueError):
+        StructDtype(POINT, byteorder='=')
+
+
+def test_nested_fields_and_pack():
+    dt = StructDtype([('id', 'u2'), ('pos', POINT), ('tag', 'S3')])
+    assert dt.itemsize == 2 + 16 + 3
+    assert dt.leaf_names == ['id', 'pos.x', 'pos.y', 'tag']
+    assert dt.pack((7, (1.0, 2.0), b'abc')) == struct.pack('<Hdd3s', 7, 1.0, 2.0, b'abc')
+    assert StructDtype(POINT) == StructDtype(POINT)
+    assert StructDtype(POINT) != StructDtype(POINT, byteorder='>')
+
+
+def test_record_array_indexing_and_views():
+    dt = [('id', 'u2'), ('pos', POINT)]
+    arr = RecordArray.from_records([(1, (0.5, 1.5)), (2, (2.5, 3.5))], dt)
+    assert len(arr) == 2
+    assert arr[1] == (2, (2.5, 3.5))
+    assert arr['id'].tolist() == [1, 2]
+    assert arr['pos.y'].tolist() == [1.5, 3.5]
+    assert arr['pos']['x'].tolist() == [0.5, 2.5]
+    with pytest.raises(KeyError):
+        arr['missing']
+    with pytest.raises(KeyError):
+        arr['id.x']
+
+
+def test_writes_go_through_views():
+    arr = RecordArray.from_records([(1, (0.0, 0.0))], [('id', 'u2'), ('pos', POINT)])
+    arr['pos.x'][0] = 4.0
+    arr[0] = (arr[0][0] + 1, arr[0][1])
+    assert arr.tolist() == [(2, (4.0, 0.0))]
+    assert struct.unpack_from('<d', arr.buffer, 2) == (4.0,)
+
+
+def test_existing_buffer_is_not_copied():
+    buf = bytearray(struct.pack('<ii', 1, 2) + struct.pack('<ii', 3, 4))
+    arr = RecordArray(buf, [('a', 'i4'), ('b', 'i4')])
+    buf[0] = 9
+    assert arr['a'].tolist() == [9, 3]
+    with pytest.raises(ValueError):
+        RecordArray(buf, [('a', 'i4'), ('b', 'i4')], count=3)
+
+
+def test_to_columnar():
+    dt = [('id', 'u2'), ('pos', POINT)]
+    arr = RecordArray.from_records([(1, (0.5, 1.5)), (2, (2.5, 3.5))], dt)
+    assert arr.to_columnar() == {'id': [1, 2], 'pos.x': [0.5, 2.5],
+                                 'pos.y': [1.5, 3.5]}
+    empty = RecordArray(b'', dt)
+    assert empty.to_columnar() == {'id': [], 'pos.x': [], 'pos.y': []}
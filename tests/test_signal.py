@@ -0,0 +1,90 @@
+import cmath
+from fractions import Fraction
+
+import pytest
+
+from arrpy.fft import fft, ifft, irfft, next_fast_len, rfft
+from arrpy import signal
+from arrpy.polynomial import polymul
+from arrpy.signal import convolve, convolve2d, correlate, fftconvolve
+
+
+def close(a, b, tol=1e-9):
+    return len(a) == len(b) and all(abs(x - y) <= tol for x, y in zip(a, b))
+
+
+def test_fft_matches_dft():
+    x = [1, 2, 0, -1, 3]
+    expected = [sum(v * cmath.exp(-2j * cmath.pi * k * n / 5)
+                    for n, v in enumerate(x)) for k in range(5)]
+    assert close(fft(x), expected)
+    assert close(ifft(fft(x)), x)
+    assert close(irfft(rfft([1.0, 2.0, 3.0, 4.0]), 4), [1, 2, 3, 4])
+    assert next_fast_len(17) >= 17
+
+
+def test_convolve_modes():
+    assert convolve([1, 2, 3], [0, 1, 0.5]) == [0, 1, 2.5, 4.0, 1.5]
+    assert convolve([1, 2, 3], [0, 1, 0.5], 'same') == [1, 2.5, 4.0]
+    assert convolve([1, 2, 3], [0, 1, 0.5], 'valid') == [2.5]
+    assert correlate([1, 2, 3], [0, 1, 0.5]) == [3.5]
+    assert correlate([1, 2, 3], [0, 1, 0.5], 'full') == [0.5, 2.0, 3.5, 3.0, 0.0]
+
+
+def test_small_integer_inputs_stay_exact():
+    assert convolve([1, 2, 3], [1, 1]) == [1, 3, 5, 3]
+    assert correlate(list(range(50)), [1, 2, 3, 4, 5, 6, 7]) == [
+        sum(i + k for k in range(7)) + sum((i + k) * k for k in range(7))
+        for i in range(44)]
+    assert convolve([Fraction(1, 3)], [3, 3]) == [1, 1]
+    assert polymul([1, 2], [3, 4]) == [3, 10, 8]
+
+
+def test_long_integer_kernels_use_the_fft(monkeypatch):
+    calls = []
+    real = signal._oa_1d
+    monkeypatch.setattr(signal, '_oa_1d',
+                        lambda *args: calls.append(1) or real(*args))
+    x = [i % 11 - 5 for i in range(1000)]
+    h = [(k * 7) % 5 - 2 for k in range(64)]
+    out = convolve(x, h)
+    assert calls
+    assert out == convolve(x, h, method='direct')
+    assert all(isinstance(v, int) for v in out)
+    # Products that could pass 2**53 stay on the exact direct path.
+    calls.clear()
+    big = [2 ** 50 + i for i in range(1000)]
+    assert convolve(big, h) == convolve(big, h, method='direct')
+    assert not calls
+
+
+def test_long_integer_2d_kernels_round_back():
+    a = [[(i * j) % 7 for j in range(40)] for i in range(40)]
+    k = [[(i + j) % 3 - 1 for j in range(15)] for i in range(15)]
+    out = convolve2d(a, k)
+    assert out == convolve2d(a, k, method='direct')
+    assert all(isinstance(v, int) for row in out for v in row)
+
+
+def test_fft_path_matches_direct():
+    x = [float(i % 7) for i in range(300)]
+    h = [0.5 ** k for k in range(40)]
+    assert close(convolve(x, h, method='fft'), convolve(x, h, method='direct'))
+    assert close(convolve(x, [1j, 2], method='fft'),
+                 convolve(x, [1j, 2], method='direct'))
+
+
+def test_2d():
+    a = [[1, 2], [3, 4]]
+    k = [[1, 1]]
+    assert convolve2d(a, k) == [[1, 3, 2], [3, 7, 4]]
+    assert convolve2d(a, k, 'same') == [[1, 3], [3, 7]]
+    full = fftconvolve(a, k)
+    assert all(close(r, e) for r, e in zip(full, [[1, 3, 2], [3, 7, 4]]))
+
+
+def test_errors():
+    with pytest.raises(ValueError):
+        convolve([], [1])
+    with pytest.raises(ValueError):
+        convolve([1], [1], mode='bad')
@@ -0,0 +1,57 @@
+import math
+
+import pytest
+
+from arrpy.sorting import topk
+
+NAN = math.nan
+
+
+def test_topk_sort_path():
+    values, idx = topk([3, 1, 4, 1, 5], 2)
+    assert values == [5, 4] and idx == [4, 2]
+    values, idx = topk([3, 1, 4, 1, 5], 3, largest=False)
+    assert values == [1, 1, 3] and idx == [1, 3, 0]
+
+
+def test_topk_heap_path_matches_sort():
+    lane = [(i * 37) % 101 for i in range(100)]
+    values, idx = topk(lane, 3)
+    assert values == [100, 99, 98]
+    assert [lane[i] for i in idx] == values
+    values, idx = topk(lane, 2, largest=False)
+    assert values == [0, 1]
+
+
+def test_topk_ties_are_stable():
+    lane = [2] * 30 + [1] * 30
+    assert topk(lane, 2)[1] == [0, 1]
+    assert topk(lane, 2, largest=False)[1] == [30, 31]
+    assert topk([2, 2, 2], 2)[1] == [0, 1]
+
+
+def test_topk_unsorted_keeps_axis_order():
+    values, idx = topk([3, 1, 4, 1, 5], 2, sorted=False)
+    assert values == [4, 5] and idx == [2, 4]
+
+
+def test_topk_along_axes():
+    m = [[1, 9, 3],
+         [7, 2, 8]]
+    assert topk(m, 1) == ([[9], [8]], [[1], [2]])
+    assert topk(m, 1, axis=0) == ([[7, 9, 8]], [[1, 0, 1]])
+    assert topk(m, 0)[0] == [[], []]
+
+
+def test_topk_nan_ranks_highest():
+    values, idx = topk([1.0, NAN, 3.0], 2)
+    assert math.isnan(values[0]) and idx == [1, 2]
+    values, idx = topk([1.0, NAN, 3.0], 2, largest=False)
+    assert values == [1.0, 3.0]
+
+
+def test_topk_errors():
+    with pytest.raises(ValueError):
+        topk(5, 1)
+    with pytest.raises(ValueError):
+        topk([1, 2], 3)
@@ -0,0 +1,56 @@
+from arrpy.sparse import coo_matrix, csc_matrix, csr_matrix, eye, merge_path_partition
+
+DENSE = [[1, 0, 2],
+         [0, 0, 3],
+         [4, 5, 0]]
+
+
+def test_round_trip_formats():
+    a = csr_matrix(DENSE)
+    assert a.shape == (3, 3)
+    assert a.nnz == 5
+    assert a.indptr == [0, 2, 3, 5]
+    assert a.toarray() == DENSE
+    assert a.tocsc().toarray() == DENSE
+    assert a.tocoo().toarray() == DENSE
+    assert a.T.toarray() == [[1, 0, 4], [0, 0, 5], [2, 3, 0]]
+    assert a.diagonal() == [1, 0, 0]
+
+
+def test_coo_duplicates_are_summed():
+    c = coo_matrix(([1, 2, 3], ([0, 0, 1], [1, 1, 0])), shape=(2, 2))
+    assert c.tocsr().toarray() == [[0, 3], [3, 0]]
+    assert c.tocsc().toarray() == [[0, 3], [3, 0]]
+
+
+def test_complex_duplicates_convert():
+    c = coo_matrix(([1j, 2 + 1j, 3], ([0, 0, 1], [1, 1, 0])), shape=(2, 2))
+    assert c.tocsr().toarray() == [[0, 2 + 2j], [3, 0]]
+    assert c.tocsc().toarray() == [[0, 2 + 2j], [3, 0]]
+
+
+def test_matvec_and_matmat():
+    a = csr_matrix(DENSE)
+    assert a.dot([1, 1, 1]) == [3, 3, 9]
+    assert a @ [[1, 0], [0, 1], [1, 1]] == [[3, 2], [3, 3], [4, 5]]
+    assert csc_matrix(DENSE).dot([1, 2, 3]) == [7, 9, 14]
+    assert [1, 1, 1] @ a == [5, 5, 5]
+    assert a.dot([1, 1, 1], workers=3) == [3, 3, 9]
+
+
+def test_matmat_int_data_with_float_rows():
+    a = csr_matrix([[1, 0], [0, 2]])
+    assert a.dot([[1.5], [2.5]]) == [[1.5], [5.0]]
+    assert a.dot([[1j], [0.5]]) == [[1j], [1.0]]
+
+
+def test_sparse_product_and_eye():
+    a = csr_matrix(DENSE)
+    assert (a @ eye(3)).toarray() == DENSE
+    assert (a @ a).toarray() == [[9, 10, 2], [12, 15, 0], [4, 0, 23]]
+
+
+def test_merge_path_partition():
+    assert merge_path_partition([0, 2, 3, 5], 1) == [0, 3]
+    bounds = merge_path_partition([0, 10, 10, 10, 10, 20], 2)
+    assert bounds[0] == 0 and bounds[-1] == 5 and len(bounds) == 3
@@ -0,0 +1,82 @@
+import pytest
+
+from arrpy.sparse import csr_matrix
+from arrpy.sparse_linalg import (bicgstab, cg, cholesky, gmres, ilu0, jacobi,
+                                 minimum_degree, spsolve)
+
+# Tridiagonal SPD matrix with A @ [1, 1, 1] == [3, 2, 3].
+SPD = [[4, -1, 0],
+       [-1, 4, -1],
+       [0, -1, 4]]
+B = [3.0, 2.0, 3.0]
+ONES = [1.0, 1.0, 1.0]
+
+# Nonsymmetric matrix with A @ [1, 2, 3] == [4, 13, 10].
+NONSYM = [[2, 1, 0],
+          [1, 3, 2],
+          [0, 2, 2]]
+
+
+def close(x, y, tol=1e-6):
+    return all(abs(a - b) <= tol for a, b in zip(x, y))
+
+
+@pytest.mark.parametrize('solver', [cg, bicgstab, gmres])
+def test_krylov_solves_spd(solver):
+    x, info = solver(csr_matrix(SPD), B, rtol=1e-10)
+    assert info == 0
+    assert close(x, ONES)
+
+
+@pytest.mark.parametrize('solver', [bicgstab, gmres])
+def test_krylov_solves_nonsymmetric(solver):
+    x, info = solver(csr_matrix(NONSYM), [4.0, 13.0, 10.0], rtol=1e-10)
+    assert info == 0
+    assert close(x, [1.0, 2.0, 3.0])
+
+
+def test_preconditioners():
+    A = csr_matrix(SPD)
+    assert jacobi(A)([4.0, 8.0, -4.0]) == [1.0, 2.0, -1.0]
+    x, info = cg(A, B, rtol=1e-10, M=jacobi(A))
+    assert info == 0 and close(x, ONES)
+    # A tridiagonal matrix has no fill, so ILU(0) is the exact LU.
+    assert close(ilu0(A)(B), ONES, 1e-12)
+    N = csr_matrix(NONSYM)
+    x, info = gmres(N, [4.0, 13.0, 10.0], M=ilu0(N))
+    assert info == 0 and close(x, [1.0, 2.0, 3.0])
+    with pytest.raises(ValueError):
+        jacobi(csr_matrix([[0, 1], [1, 0]]))
+
+
+def test_minimum_degree_eliminates_leaves_first():
+    # Star graph: the hub (node 0) must go last.
+    star = [[4, 1, 1, 1],
+            [1, 4, 0, 0],
+            [1, 0, 4, 0],
+            [1, 0, 0, 4]]
+    perm = minimum_degree(csr_matrix(star))
+    assert sorted(perm) == [0, 1, 2, 3]
+    assert perm[-1] == 0 or perm[-2] == 0
+
+
+def test_cholesky_factor_and_solve():
+    A = csr_matrix([[4, 2], [2, 5]])
+    factor = cholesky(A, ordering='natural')
+    # L = [[2, 0], [1, 2]].
+    assert factor.L.toarray() == [[2.0, 0.0], [1.0, 2.0]]
+    assert close(factor.solve([6.0, 7.0]), [1.0, 1.0], 1e-12)
+    assert close(spsolve(csr_matrix(SPD), B), ONES, 1e-12)
+    with pytest.raises(ValueError):
+        cholesky(csr_matrix([[1, 2], [2, 1]]))
+    with pytest.raises(ValueError):
+        cholesky(A, ordering='bogus')
+
+
+def test_breakdown_returns_negative_count():
+    # p^T A p vanishes on the first step for this indefinite matrix.
+    x, info = cg(csr_matrix([[1, 0], [0, -1]]), [1.0, 1.0])
+    assert info == -1 and x == [0.0, 0.0]
+    # A maps b's direction to zero, so the Hessenberg diagonal is zero.
+    x, info = gmres(csr_matrix([[0, 1], [0, 0]]), [1.0, 0.0])
+    assert info == -1 and x == [0.0, 0.0]
@@ -0,0 +1,110 @@
+import math
+import random
+
+import pytest
+
+from arrpy.spatial import IVFFlat, KDTree, cdist, knn, pdist, squareform
+
+A = [[0.0, 0.0], [3.0, 4.0]]
+B = [[0.0, 0.0], [1.0, 0.0], [0.0, 2.0]]
+
+
+def test_cdist_metrics():
+    assert cdist(A, B) == [[0.0, 1.0, 2.0], [5.0, math.sqrt(20), math.sqrt(13)]]
+    assert cdist(A, B, 'sqeuclidean')[1] == pytest.approx([25.0, 20.0, 13.0])
+    assert cdist(A, B, 'cityblock')[1] == [7.0, 6.0, 5.0]
+    assert cdist(A, B, 'chebyshev')[1] == [4.0, 4.0, 3.0]
+    cos = cdist([[1.0, 0.0]], [[0.0, 1.0], [2.0, 0.0]], 'cosine')
+    assert cos == [[1.0, 0.0]]
+    assert cdist([[1, 0, 1]], [[1, 1, 0]], 'hamming') == [[2 / 3]]
+    assert cdist([[1, 0, 1]], [[1, 1, 0]], 'jaccard') == [[2 / 3]]
+    assert cdist(A, B, lambda u, v: u[0] + v[1]) == [[0.0, 0.0, 2.0],
+                                                     [3.0, 3.0, 5.0]]
+
+
+def test_euclidean_matches_math_dist():
+    rng = random.Random(0)
+    X = [[rng.uniform(-1, 1) for _ in range(16)] for _ in range(20)]
+    D = cdist(X, X)
+    assert all(D[i][j] == math.dist(X[i], X[j])
+               for i in range(20) for j in range(20))
+    assert all(D[i][i] == 0.0 for i in range(20))
+
+
+def test_pdist_and_squareform():
+    X = [[0.0], [1.0], [3.0]]
+    d = pdist(X)
+    assert d == [1.0, 3.0, 2.0]
+    square = squareform(d)
+    assert square == [[0.0, 1.0, 3.0], [1.0, 0.0, 2.0], [3.0, 2.0, 0.0]]
+    assert squareform(square) == d
+    assert pdist(X, workers=2) == d
+
+
+def test_errors():
+    with pytest.raises(ValueError):
+        cdist([[1.0, 2.0]], [[1.0]])
+    with pytest.raises(ValueError):
+        cdist(A, B, 'nope')
+    with pytest.raises(ValueError):
+        squareform([1.0, 2.0])
+
+
+GRID = [[float(x), float(y)] for x in range(4) for y in range(4)]
+
+
+def test_knn_brute_force():
+    dist, idx = knn(GRID, [0.1, 0.2], k=3)
+    assert idx == [0, 1, 4]
+    assert dist[0] == math.dist([0.1, 0.2], [0.0, 0.0])
+    d, i = knn(GRID, [[3.0, 3.0], [0.0, 3.1]], k=1, metric='cityblock')
+    assert i == [15, 3] and d[0] == 0.0
+
+
+def test_kdtree_matches_knn():
+    rng = random.Random(3)
+    data = [[rng.random() for _ in range(3)] for _ in range(200)]
+    queries = [[rng.random() for _ in range(3)] for _ in range(20)]
+    tree = KDTree(data, leafsize=4)
+    for p, metric in [(2, 'euclidean'), (1, 'cityblock'), (math.inf, 'chebyshev')]:
+        got = tree.query(queries, k=5, p=p)
+        want = knn(data, queries, k=5, metric=metric)
+        assert got[1] == want[1]
+        assert all(math.isclose(a, b) for ra, rb in zip(got[0], want[0])
+                   for a, b in zip(ra, rb))
+    assert tree.query(queries, k=2, workers=4) == tree.query(queries, k=2)
+
+
+def test_kdtree_bounds_and_duplicates():
+    tree = KDTree([[1.0, 1.0]] * 5 + [[5.0, 5.0]], leafsize=1)
+    dist, idx = tree.query([1.0, 1.0], k=3)
+    assert dist == [0.0, 0.0, 0.0] and idx == [0, 1, 2]
+    dist, idx = tree.query([5.0, 4.0], k=3, distance_upper_bound=2.0)
+    assert dist == [1.0, math.inf, math.inf] and idx == [5, -1, -1]
+    assert KDTree([]).query([0.0, 0.0]) == (math.inf, -1)
+    with pytest.raises(ValueError):
+        tree.query([1.0], k=1)
+    with pytest.raises(ValueError):
+        tree.query([1.0, 1.0], k=0)
+
+
+def test_query_ball_point():
+    tree = KDTree(GRID, leafsize=2)
+    assert tree.query_ball_point([0.0, 0.0], 1.0) == [0, 1, 4]
+    assert tree.query_ball_point([[1.0, 1.0]], 1.0, p=math.inf) == [
+        [0, 1, 2, 4, 5, 6, 8, 9, 10]]
+
+
+def test_ivfflat_exact_when_probing_all_lists():
+    rng = random.Random(5)
+    data = [[rng.random(), rng.random()] for _ in range(100)]
+    queries = [[rng.random(), rng.random()] for _ in range(10)]
+    index = IVFFlat(data, nlist=8, seed=0)
+    assert sorted(i for lst in index.lists for i in lst) == list(range(100))
+    assert index.query(queries, k=3, nprobe=8) == knn(data, queries, k=3)
+    dist, idx = index.query(data[7], k=1, nprobe=1)
+    assert (dist, idx) == (0.0, 7)
+    with pytest.raises(ValueError):
+        IVFFlat(data, nlist=0)
+    with pytest.raises(ValueError, match='at least one data row'):
+        IVFFlat([])
@@ -0,0 +1,76 @@
+from array import array
+
+import pytest
+
+from arrpy.strings import FixedStringArray, StringArray
+
+WORDS = ['pear', 'apple', '', 'äpfel']
+
+
+def test_string_array_layout():
+    s = StringArray(WORDS)
+    assert list(s.offsets) == [0, 4, 9, 9, 15]
+    assert s.data == 'pearapple'.encode() + 'äpfel'.encode()
+    assert s.nbytes == 15 + 5 * 8
+    assert s.tolist() == WORDS
+    assert s[1] == 'apple' and s[-1] == 'äpfel'
+    with pytest.raises(TypeError):
+        StringArray(['a', 1])
+
+
+def test_frombuffers_wraps_without_copy():
+    data = b'abcde'
+    s = StringArray.frombuffers(array('q', [0, 2, 5]), data)
+    assert s.data is data
+    assert s.tolist() == ['ab', 'cde']
+    with pytest.raises(ValueError):
+        StringArray.frombuffers([0, 6], data)
+
+
+def test_fixed_string_array_layout():
+    f = FixedStringArray(['ab', 'c', ''])
+    assert f.width == 2
+    assert f.data == b'abc\0\0\0'
+    assert f.tolist() == ['ab', 'c', '']
+    assert FixedStringArray.frombuffer(b'xy\0z', 2).tolist() == ['xy', '']
+    with pytest.raises(ValueError):
+        FixedStringArray(['abc'], width=2)
+    with pytest.raises(ValueError):
+        FixedStringArray.frombuffer(b'abc', 2)
+
+
+@pytest.mark.parametrize('cls', [StringArray, FixedStringArray])
+def test_elementwise_queries(cls):
+    s = cls(WORDS)
+    assert len(s) == 4
+    assert s.str_len() == [4, 5, 0, 5]
+    assert s.startswith('p') == [True, False, False, False]
+    assert s.endswith('el') == [False, False, False, True]
+    assert s.find('p') == [0, 1, -1, 1]
+    assert (s == 'apple') == [False, True, False, False]
+    assert (s != 'apple') == [True, False, True, True]
+    assert 'pear' in s and 'plum' not in s
+    assert s.hash()[1] == hash('apple'.encode())
+
+
+@pytest.mark.parametrize('cls', [StringArray, FixedStringArray])
+def test_take_sort_and_case(cls):
+    s = cls(WORDS)
+    assert s[1:3].tolist() == ['apple', '']
+    assert s.take([3, -4]).tolist() == ['äpfel', 'pear']
+    with pytest.raises(IndexError):
+        s.take([4])
+    # Byte order is code point order, so 'ä' sorts after ASCII.
+    assert s.argsort() == [2, 1, 0, 3]
+    assert s.sort().tolist() == ['', 'apple', 'pear', 'äpfel']
+    assert s.upper().tolist() == ['PEAR', 'APPLE', '', 'ÄPFEL']
+    ascii_only = cls(['Ab', 'cD'])
+    assert ascii_only.lower().tolist() == ['ab', 'cd']
+
+
+def test_compare_two_arrays():
+    a = StringArray(['x', 'yy'])
+    b = FixedStringArray(['x', 'y'])
+    assert (a == b) == [True, False]
+    with pytest.raises(ValueError):
+        a == StringArray(['x'])
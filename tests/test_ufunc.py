@@ -0,0 +1,115 @@
+import math
+
+import pytest
+
+from arrpy.core import ieee_div
+from arrpy.ufunc import (UFUNCS, add, broadcast_shapes, divide, frompyfunc,
+                         gufunc, maximum, minimum, multiply, negative,
+                         register_gufunc, register_ufunc, subtract)
+
+
+def test_broadcast_shapes():
+    assert broadcast_shapes((2, 1), (3,)) == (2, 3)
+    assert broadcast_shapes((), (4,)) == (4,)
+    with pytest.raises(ValueError):
+        broadcast_shapes((2,), (3,))
+
+
+def test_binary_broadcasting_and_scalars():
+    assert add([[1], [2]], [10, 20, 30]) == [[11, 21, 31], [12, 22, 32]]
+    assert multiply(2, [1, 2]) == [2, 4]
+    assert add(1, 2) == 3
+    assert negative([[1, -2]]) == [[-1, 2]]
+
+
+def test_out_argument():
+    out = [[0, 0], [0, 0]]
+    result = add([[1, 2], [3, 4]], 1, out=out)
+    assert result is out and out == [[2, 3], [4, 5]]
+
+
+def test_divide_follows_ieee():
+    assert divide([1.0, -1.0, 3], [0.0, 0.0, 2]) == [math.inf, -math.inf, 1.5]
+    assert math.isnan(divide(0.0, 0.0))
+    assert ieee_div(1, -0.0) == -math.inf
+    assert ieee_div(6, 3) == 2.0
+
+
+def test_maximum_propagates_nan():
+    assert maximum([1, 5], [3, 2]) == [3, 5]
+    assert math.isnan(maximum(math.nan, 1.0))
+    assert math.isnan(maximum(1.0, math.nan))
+
+
+def test_gufunc_signature():
+    inner = gufunc(lambda a, b: sum(x * y for x, y in zip(a, b)), '(n),(n)->()')
+    assert inner([[1, 2], [3, 4]], [1, 1]) == [3, 7]
+    with pytest.raises(ValueError):
+        inner([1, 2], [1, 2, 3])
+
+
+def test_registration():
+    @register_ufunc()
+    def _test_hypot2(x, y):
+        return x * x + y * y
+
+    @register_gufunc('(n)->()')
+    def _test_total(a):
+        return sum(a)
+
+    assert UFUNCS['_test_hypot2'] is _test_hypot2
+    assert _test_hypot2([3, 0], 4) == [25, 16]
+    assert _test_total([[1, 2], [3, 4]]) == [3, 7]
+    assert frompyfunc(lambda x: x + 1, 1, 1)([1, 2]) == [2, 3]
+
+
+M = [[1, 2, 3],
+     [4, 5, 6]]
+
+
+def test_reduce_axes():
+    assert add.reduce(M) == [5, 7, 9]
+    assert add.reduce(M, axis=1) == [6, 15]
+    assert add.reduce(M, axis=None) == 21
+    assert multiply.reduce(M, axis=-1, keepdims=True) == [[6], [120]]
+    assert maximum.reduce(M, axis=None, keepdims=True) == [[6]]
+    assert add.reduce([1, 2], initial=10) == 13
+    assert minimum.reduce([[3, 1], [2, 4]], axis=0) == [2, 1]
+
+
+def test_reduce_empty_axis():
+    assert add.reduce([]) == 0
+    assert multiply.reduce([]) == 1
+    assert maximum.reduce([], initial=-1) == -1
+    with pytest.raises(ValueError):
+        maximum.reduce([])
+
+
+def test_accumulate():
+    assert add.accumulate([1, 2, 3, 4]) == [1, 3, 6, 10]
+    assert subtract.accumulate([10, 1, 2]) == [10, 9, 7]
+    assert multiply.accumulate(M, axis=0) == [[1, 2, 3], [4, 10, 18]]
+    assert maximum.accumulate(M, axis=1) == [[1, 2, 3], [4, 5, 6]]
+
+
+def test_reduceat():
+    x = [1, 2, 3, 4, 5, 6]
+    assert add.reduceat(x, [0, 2, 5]) == [3, 12, 6]
+    # A non-increasing pair yields the element at the first index.
+    assert add.reduceat(x, [3, 1]) == [4, 20]
+    assert add.reduceat(M, [0, 2], axis=1) == [[3, 3], [9, 6]]
+    assert add.reduceat(M, [0], axis=0) == [[5, 7, 9]]
+    with pytest.raises(IndexError):
+        add.reduceat(x, [6])
+
+
+def test_outer():
+    assert multiply.outer([1, 2], [10, 20, 30]) == [[10, 20, 30], [20, 40, 60]]
+    assert subtract.outer(5, [1, 2]) == [4, 3]
+    assert add.outer(1, 2) == 3
+    assert len(add.outer(M, [0, 0])[1][2]) == 2
+
+
+def test_reductions_need_binary_ufunc():
+    with pytest.raises(ValueError):
+        negative.reduce([1, 2])
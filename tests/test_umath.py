@@ -0,0 +1,60 @@
+import math
+
+import pytest
+
+from arrpy import umath
+
+INF, NAN = math.inf, math.nan
+
+
+def test_shapes_are_preserved():
+    assert umath.sqrt(4.0) == 2.0
+    assert umath.sqrt([1.0, 4.0, 9.0]) == [1.0, 2.0, 3.0]
+    assert umath.exp([[0.0], [0.0]]) == [[1.0], [1.0]]
+    assert umath.log2([]) == []
+    assert umath.sin.__name__ == 'sin'
+
+
+def test_values_match_math():
+    xs = [0.1, 0.5, 2.0]
+    for name, func in [('exp', math.exp), ('log1p', math.log1p),
+                       ('tanh', math.tanh), ('erfc', math.erfc),
+                       ('lgamma', math.lgamma)]:
+        assert getattr(umath, name)(xs) == list(map(func, xs))
+    assert umath.rsqrt([4.0, 0.25]) == [0.5, 2.0]
+
+
+def test_ieee_special_values():
+    assert umath.log([0.0, 1.0]) == [-INF, 0.0]
+    assert math.isnan(umath.log(-1.0))
+    assert math.isnan(umath.sqrt(-1.0))
+    assert umath.log1p(-1.0) == -INF
+    assert umath.exp([1000.0, 0.0]) == [INF, 1.0]
+    assert umath.sinh(-1000.0) == -INF
+    assert umath.rsqrt([0.0, -0.0]) == [INF, -INF]
+    assert umath.gamma([0.0, -0.0]) == [INF, -INF]
+    assert math.isnan(umath.gamma(-2.0))
+    assert umath.lgamma(0.0) == INF
+    # A single bad element does not disturb the others.
+    out = umath.arcsin([0.0, 2.0])
+    assert out[0] == 0.0 and math.isnan(out[1])
+
+
+def test_fast_mode_raises():
+    with pytest.raises(ValueError):
+        umath.log([1.0, 0.0], fast=True)
+    with pytest.raises(OverflowError):
+        umath.exp(1000.0, fast=True)
+
+
+def test_binary_functions():
+    assert umath.arctan2([1.0, -1.0], 0.0) == [math.pi / 2, -math.pi / 2]
+    assert umath.power([2.0, 3.0], 2.0) == [4.0, 9.0]
+    assert umath.power(2.0, [[0.5]]) == [[math.sqrt(2.0)]]
+    assert umath.power([0.0, -0.0, -0.0], [-1.0, -1.0, -2.0]) == [INF, -INF, INF]
+    assert umath.power([10.0, -10.0], [400.0, 401.0]) == [INF, -INF]
+    assert math.isnan(umath.power(-8.0, 1 / 3))
+    with pytest.raises(ValueError):
+        umath.power([1.0, 2.0], [1.0, 2.0, 3.0])
+    with pytest.raises(ValueError):
+        umath.power(0.0, -1.0, fast=True)
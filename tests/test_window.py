@@ -0,0 +1,59 @@
+import math
+
+import pytest
+
+from arrpy.window import rolling, sliding_window_view
+
+X = [1, 3, 2, 5, 4]
+
+
+def test_sliding_window_view_1d_and_2d():
+    assert sliding_window_view(X, 3) == [[1, 3, 2], [3, 2, 5], [2, 5, 4]]
+    grid = [[1, 2, 3],
+            [4, 5, 6]]
+    assert sliding_window_view(grid, 2, axis=1) == [
+        [[1, 2], [2, 3]],
+        [[4, 5], [5, 6]]]
+    assert sliding_window_view(grid, (2, 2)) == [
+        [[[1, 2], [4, 5]], [[2, 3], [5, 6]]]]
+    with pytest.raises(ValueError):
+        sliding_window_view(X, 6)
+    with pytest.raises(ValueError):
+        sliding_window_view(grid, (2, 2), axis=0)
+
+
+def test_rolling_sum_mean_extremes():
+    r = rolling(X, 3)
+    assert r.sum() == [6, 10, 11]
+    assert r.mean() == [2.0, 10 / 3, 11 / 3]
+    assert r.min() == [1, 2, 2]
+    assert r.max() == [3, 5, 5]
+
+
+def test_rolling_moments():
+    r = rolling(X, 3)
+    # Windows [1,3,2], [3,2,5], [2,5,4]: population variances 2/3, 14/9, 14/9.
+    expected = [2 / 3, 14 / 9, 14 / 9]
+    assert all(math.isclose(a, b) for a, b in zip(r.var(), expected))
+    sample = [v * 3 / 2 for v in expected]
+    assert all(math.isclose(a, b) for a, b in zip(r.var(ddof=1), sample))
+    assert all(math.isclose(a, math.sqrt(b)) for a, b in zip(r.std(), expected))
+
+
+def test_rolling_quantiles():
+    r = rolling(X, 3)
+    assert r.median() == [2, 3, 4]
+    assert r.quantile(0.0) == r.min()
+    assert r.quantile(0.25) == [1.5, 2.5, 3.0]
+    assert rolling([1, 2, 3, 4], 2).median() == [1.5, 2.5, 3.5]
+    with pytest.raises(ValueError):
+        r.quantile(1.5)
+
+
+def test_rolling_along_axis():
+    grid = [[1, 2, 3],
+            [4, 5, 6]]
+    assert rolling(grid, 2, axis=1).sum() == [[3, 5], [9, 11]]
+    assert rolling(grid, 2, axis=0).max() == [[4, 5, 6]]
+    with pytest.raises(ValueError):
+        rolling(grid, 3, axis=0)